@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal Google-Benchmark style harness for the bench target.
+//
+//     void BM_thing(BenchState& state)
+//     {
+//         while (state.keepRunning())
+//             ...;
+//         state.setItemsProcessed(state.iterations() * state.range());
+//     }
+//
+// Allocations are counted by bench.cpp's malloc hooks through g_Allocations.
+
+inline std::atomic<std::size_t> g_Allocations{0};
+
+// keep the compiler from optimizing away a value
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class BenchState
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t m_Range;
+    std::size_t m_Iterations;
+    std::size_t m_Remaining;
+    bool m_Started = false;
+    bool m_Running = false;
+    Clock::time_point m_Start;
+    double m_ElapsedNs = 0;
+    std::size_t m_AllocStart = 0;
+    std::size_t m_Allocations = 0;
+    std::size_t m_BytesMoved = 0;
+    std::size_t m_Items = 0;
+
+public:
+    BenchState(std::size_t range, std::size_t iterations)
+        : m_Range(range),
+        m_Iterations(iterations),
+        m_Remaining(iterations)
+    {
+    }
+
+    // true until the requested number of iterations has run, times everything in between
+    bool keepRunning()
+    {
+        if (!m_Started)
+        {
+            m_Started = true;
+            resumeTiming();
+        }
+        if (m_Remaining == 0)
+        {
+            if (m_Running)
+                pauseTiming();
+            return false;
+        }
+        --m_Remaining;
+        return true;
+    }
+
+    // exclude setup work from the measurement
+    void pauseTiming()
+    {
+        m_ElapsedNs += std::chrono::duration<double, std::nano>(Clock::now() - m_Start).count();
+        m_Allocations += g_Allocations.load(std::memory_order_relaxed) - m_AllocStart;
+        m_Running = false;
+    }
+
+    void resumeTiming()
+    {
+        m_AllocStart = g_Allocations.load(std::memory_order_relaxed);
+        m_Running = true;
+        m_Start = Clock::now();
+    }
+
+    std::size_t range() const
+    {
+        return m_Range;
+    }
+
+    std::size_t iterations() const
+    {
+        return m_Iterations;
+    }
+
+    // bytes of element data copied or moved, whatever the container did to get there
+    void addBytesMoved(std::size_t bytes)
+    {
+        m_BytesMoved += bytes;
+    }
+
+    // operations timed, ns/op is the elapsed time divided by this
+    void setItemsProcessed(std::size_t items)
+    {
+        m_Items = items;
+    }
+
+    double elapsedNs() const
+    {
+        return m_ElapsedNs;
+    }
+
+    std::size_t allocations() const
+    {
+        return m_Allocations;
+    }
+
+    std::size_t bytesMoved() const
+    {
+        return m_BytesMoved;
+    }
+
+    std::size_t items() const
+    {
+        return m_Items ? m_Items : m_Iterations;
+    }
+};
+
+struct Benchmark
+{
+    std::string op;
+    std::string container;
+    std::string type;
+    std::size_t elementSize;
+    std::function<void(BenchState&)> fn;
+};
+
+struct BenchResult
+{
+    std::string name;
+    const Benchmark* benchmark;
+    std::size_t size;
+    std::size_t iterations;
+    double nsPerOp;
+    double allocations;
+    double bytesMoved;
+};
+
+inline std::vector<Benchmark>& benchmarks()
+{
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+inline void registerBenchmark(std::string op, std::string container, std::string type,
+                              std::size_t elementSize, std::function<void(BenchState&)> fn)
+{
+    benchmarks().push_back({std::move(op), std::move(container), std::move(type), elementSize, std::move(fn)});
+}
+
+inline std::string benchName(const Benchmark& bm, std::size_t size)
+{
+    return bm.op + "/" + bm.container + "<" + bm.type + ">/" + std::to_string(size);
+}
+
+// run one benchmark at one size, growing the iteration count until it runs for minTime
+inline BenchResult runBenchmark(const Benchmark& bm, std::size_t size, double minTimeNs)
+{
+    std::size_t iterations = 1;
+    while (true)
+    {
+        auto start = std::chrono::steady_clock::now();
+        BenchState state(size, iterations);
+        bm.fn(state);
+        double wallNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        // untimed setup counts towards the wall clock budget so huge sizes don't run forever
+        if (state.elapsedNs() >= minTimeNs || wallNs >= 10 * minTimeNs || iterations >= 1000000000)
+        {
+            return {benchName(bm, size), &bm, size, iterations, state.elapsedNs() / state.items(),
+                    double(state.allocations()) / iterations, double(state.bytesMoved()) / iterations};
+        }
+        double scale = state.elapsedNs() > 0 ? minTimeNs * 1.4 / state.elapsedNs() : 100;
+        iterations = std::max(iterations + 1, std::size_t(iterations * std::min(scale, 100.0)));
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// A growth policy decides the next capacity when MyVector runs out of room.
+// grow() must return a capacity of at least `required` elements. Near the
+// top of the range the policies saturate at SIZE_MAX instead of wrapping to a
+// small capacity; MyVector then throws std::length_error.
+
+// capacity * Num / Den, the default (3/2) matches the original 1.5x growth
+template<std::size_t Num = 3, std::size_t Den = 2>
+struct GeometricGrowth
+{
+    static_assert(Num > Den, "growth factor must be greater than 1");
+
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t /*elementSize*/)
+    {
+        // an empty vector starts with room for two, like the old eager default
+        if (capacity == 0)
+            return std::max<std::size_t>(required, 2);
+        if (capacity > SIZE_MAX / Num)
+            return SIZE_MAX;
+        return std::max(capacity * Num / Den, required);
+    }
+};
+
+// next power of two that fits the request
+struct PowerOfTwoGrowth
+{
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t /*elementSize*/)
+    {
+        constexpr std::size_t Largest = (SIZE_MAX >> 1) + 1;
+        if (capacity >= Largest || required > Largest)
+            return SIZE_MAX;
+        return std::bit_ceil(std::max(capacity + 1, required));
+    }
+};
+
+// geometric growth, then round the buffer up to a whole number of pages
+template<std::size_t PageSize = 4096, std::size_t Num = 3, std::size_t Den = 2>
+struct PageRoundedGrowth
+{
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t elementSize)
+    {
+        std::size_t cap = GeometricGrowth<Num, Den>::grow(capacity, required, elementSize);
+        if (cap > (SIZE_MAX - PageSize) / elementSize)
+            return cap;
+        std::size_t bytes = (cap * elementSize + PageSize - 1) / PageSize * PageSize;
+        return std::max(bytes / elementSize, cap);
+    }
+};
+
+// add Chunk elements at a time
+template<std::size_t Chunk = 1024>
+struct FixedChunkGrowth
+{
+    static_assert(Chunk > 0, "chunk size must be positive");
+
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t /*elementSize*/)
+    {
+        if (capacity > SIZE_MAX - Chunk || required > SIZE_MAX - Chunk)
+            return SIZE_MAX;
+        std::size_t cap = capacity + Chunk;
+        if (cap < required)
+            cap = (required + Chunk - 1) / Chunk * Chunk;
+        return cap;
+    }
+};
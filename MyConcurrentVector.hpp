@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Append-only vector that any number of threads can push_back into without
+// locks. Elements live in segments that double in size and are never moved,
+// so references stay valid and readers can walk the published elements while
+// writers keep appending.
+//
+// A writer allocates the segment of the next free index if it is the first
+// to reach it, claims that index with a compare-exchange, constructs the
+// element and marks its slot ready. size() only counts the prefix of ready slots, so readers
+// never see a half-built element.
+template <typename T, std::size_t FirstSegment = 64>
+class MyConcurrentVector
+{
+    static_assert(std::has_single_bit(FirstSegment), "first segment size must be a power of two");
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<bool> ready{false};
+
+        T* get()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static constexpr std::size_t FirstShift = std::countr_zero(FirstSegment);
+    static constexpr std::size_t MaxSegments = 64 - FirstShift;
+
+    std::atomic<Slot*> m_Segments[MaxSegments] = {};
+    std::atomic<std::size_t> m_Reserved{0};
+    std::atomic<std::size_t> m_Published{0};
+
+public:
+    using ValueType = T;
+
+    class Iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = T*;
+        using reference = T&;
+        using iterator_category = std::forward_iterator_tag;
+
+    private:
+        MyConcurrentVector* m_Vector = nullptr;
+        std::size_t m_Index = 0;
+
+    public:
+        Iterator()
+        {
+        }
+
+        Iterator(MyConcurrentVector* vector, std::size_t index)
+            : m_Vector(vector),
+            m_Index(index)
+        {
+        }
+
+        Iterator& operator++()
+        {
+            m_Index++;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            m_Index++;
+            return temp;
+        }
+
+        reference operator*() const
+        {
+            return (*m_Vector)[m_Index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*m_Vector)[m_Index];
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return m_Index == other.m_Index;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return m_Index != other.m_Index;
+        }
+    };
+
+private:
+    // segment k holds FirstSegment << k elements and starts at FirstSegment * (2^k - 1)
+    static std::size_t segmentOf(std::size_t index)
+    {
+        return std::bit_width((index >> FirstShift) + 1) - 1;
+    }
+
+    static std::size_t segmentStart(std::size_t segment)
+    {
+        return ((std::size_t(1) << segment) - 1) << FirstShift;
+    }
+
+    static std::size_t segmentSize(std::size_t segment)
+    {
+        return FirstSegment << segment;
+    }
+
+    Slot& slot(std::size_t index)
+    {
+        std::size_t segment = segmentOf(index);
+        return m_Segments[segment].load(std::memory_order_acquire)[index - segmentStart(segment)];
+    }
+
+    // the slot's segment may not be allocated yet if its writer is still on the way
+    bool isReady(std::size_t index)
+    {
+        std::size_t segment = segmentOf(index);
+        Slot* slots = m_Segments[segment].load(std::memory_order_acquire);
+        return slots && slots[index - segmentStart(segment)].ready.load();
+    }
+
+    // the first writer to reach a segment allocates it, losers free theirs
+    Slot& reserveSlot(std::size_t index)
+    {
+        std::size_t segment = segmentOf(index);
+        Slot* slots = m_Segments[segment].load(std::memory_order_acquire);
+        if (!slots)
+        {
+            Slot* fresh = new Slot[segmentSize(segment)];
+            if (m_Segments[segment].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel))
+                slots = fresh;
+            else
+                delete[] fresh;
+        }
+        return slots[index - segmentStart(segment)];
+    }
+
+    // move m_Published past every ready slot, any writer can finish another's work
+    void publish()
+    {
+        std::size_t published = m_Published.load(std::memory_order_acquire);
+        while (published < m_Reserved.load(std::memory_order_acquire) && isReady(published))
+        {
+            if (m_Published.compare_exchange_weak(published, published + 1, std::memory_order_acq_rel))
+                ++published;
+        }
+    }
+
+    // The segment is allocated before the index is claimed: a bad_alloc then
+    // leaves nothing reserved, so publish() can't stall on a slot that will
+    // never be ready and the destructor never sees a missing segment.
+    template<typename... Args>
+    std::size_t construct(Args&&... args)
+    {
+        std::size_t index = m_Reserved.load(std::memory_order_acquire);
+        Slot* s;
+        do
+        {
+            s = &reserveSlot(index);
+        } while (!m_Reserved.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel));
+        new(s->storage) T(std::forward<Args>(args)...);
+        s->ready.store(true);
+        publish();
+        return index;
+    }
+
+public:
+    MyConcurrentVector()
+    {
+    }
+
+    MyConcurrentVector(const MyConcurrentVector&) = delete;
+    MyConcurrentVector& operator=(const MyConcurrentVector&) = delete;
+
+    // no other thread may be using the vector
+    ~MyConcurrentVector()
+    {
+        std::size_t count = m_Reserved.load();
+        for (std::size_t i = 0; i < count; i++)
+            slot(i).get()->~T();
+        for (auto& segment : m_Segments)
+            delete[] segment.load();
+    }
+
+    // append an element, returns its index
+    std::size_t push_back(const T& item)
+    {
+        return emplace_back(item);
+    }
+
+    std::size_t push_back(T&& item)
+    {
+        return emplace_back(std::move(item));
+    }
+
+    // A throwing constructor would leave a reserved slot that is never
+    // published, so the element is built before reserving and the slot is
+    // only claimed once its segment exists.
+    template<typename... Args>
+    std::size_t emplace_back(Args&&... args)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+        {
+            return construct(std::forward<Args>(args)...);
+        }
+        else
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow move constructible");
+            T item(std::forward<Args>(args)...);
+            return construct(std::move(item));
+        }
+    }
+
+    // only valid for index < size()
+    T& operator[](const std::size_t& index)
+    {
+        return *slot(index).get();
+    }
+
+    T& at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return (*this)[index];
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+
+    // the published elements as of this call
+    Iterator end()
+    {
+        return Iterator(this, size());
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    // number of elements every thread can safely read
+    std::size_t size() const
+    {
+        return m_Published.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "MyVector.hpp"
+
+// Vector whose copies share one buffer until one of them changes. Copying
+// only bumps an atomic reference count, so a writer can publish read-only
+// snapshots every tick in O(1); the first change made while the buffer is
+// shared copies the elements once and carries on with the copy.
+//
+// Every non-const call that hands out elements (operator[], at, data, begin,
+// front, back) detaches too, and what it returns may only be written through
+// until this vector is copied again.
+//
+// Snapshots can be read and dropped from any thread. Like std::shared_ptr,
+// one MyCowVector object must not be copied and changed at the same time.
+template <typename T, typename GrowthPolicy = GeometricGrowth<>>
+class MyCowVector
+{
+private:
+    using Elements = MyVector<T, GrowthPolicy>;
+
+    struct Buffer
+    {
+        std::atomic<std::size_t> refs{1};
+        Elements elements;
+
+        Buffer()
+        {
+        }
+
+        explicit Buffer(Elements from)
+            : elements(std::move(from))
+        {
+        }
+    };
+
+    // drop one reference; the last owner must see every other owner's accesses done
+    static void unref(Buffer* buffer)
+    {
+        if (buffer && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete buffer;
+    }
+
+    struct Unref
+    {
+        void operator()(Buffer* buffer) const
+        {
+            unref(buffer);
+        }
+    };
+
+    using Previous = std::unique_ptr<Buffer, Unref>;
+
+    Buffer* m_Buffer = nullptr; // null while empty
+
+public:
+    using ValueType = T;
+    using Policy = GrowthPolicy;
+    using Iterator = MyVectorIterator<MyCowVector>;
+    using ConstIterator = MyVectorIterator<MyCowVector, true>;
+
+private:
+    // Make this vector the only owner of its buffer. A shared buffer is
+    // copied and the reference to it is returned, for the caller to drop
+    // once done: arguments of the call may still point into it.
+    [[nodiscard]] Previous unshare()
+    {
+        if (!m_Buffer)
+        {
+            m_Buffer = new Buffer();
+            return nullptr;
+        }
+        if (m_Buffer->refs.load(std::memory_order_acquire) == 1)
+            return nullptr;
+
+        Buffer* copy = new Buffer(m_Buffer->elements);
+        return Previous(std::exchange(m_Buffer, copy));
+    }
+
+    // run fn on elements nobody else can see
+    template<typename Fn>
+    decltype(auto) write(Fn&& fn)
+    {
+        Previous previous = unshare();
+        return fn(m_Buffer->elements);
+    }
+
+public:
+    MyCowVector()
+    {
+    }
+
+    MyCowVector(std::initializer_list<T> l)
+    {
+        if (l.size())
+            m_Buffer = new Buffer(Elements(l));
+    }
+
+    // take over a vector's elements without copying them
+    explicit MyCowVector(Elements elements)
+    {
+        if (!elements.empty())
+            m_Buffer = new Buffer(std::move(elements));
+    }
+
+    MyCowVector(const MyCowVector& array)
+        : m_Buffer(array.m_Buffer)
+    {
+        if (m_Buffer)
+            m_Buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    MyCowVector(MyCowVector&& array) noexcept
+        : m_Buffer(std::exchange(array.m_Buffer, nullptr))
+    {
+    }
+
+    MyCowVector& operator=(const MyCowVector& array)
+    {
+        if (m_Buffer != array.m_Buffer)
+        {
+            if (array.m_Buffer)
+                array.m_Buffer->refs.fetch_add(1, std::memory_order_relaxed);
+            unref(std::exchange(m_Buffer, array.m_Buffer));
+        }
+        return *this;
+    }
+
+    MyCowVector& operator=(MyCowVector&& array) noexcept
+    {
+        if (this != &array)
+            unref(std::exchange(m_Buffer, std::exchange(array.m_Buffer, nullptr)));
+        return *this;
+    }
+
+    ~MyCowVector()
+    {
+        unref(m_Buffer);
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return data()[index];
+    }
+
+    T& operator[](const std::size_t& index)
+    {
+        return data()[index];
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    T& at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    void reserve(const std::size_t& n)
+    {
+        write([&](Elements& elements) { elements.reserve(n); });
+    }
+
+    void resize(const std::size_t& n)
+    {
+        write([&](Elements& elements) { elements.resize(n); });
+    }
+
+    void resize(const std::size_t& n, const T& value)
+    {
+        write([&](Elements& elements) { elements.resize(n, value); });
+    }
+
+    void shrinkToFit()
+    {
+        if (m_Buffer)
+            write([](Elements& elements) { elements.shrinkToFit(); });
+    }
+
+    // a shared buffer is left to its other owners instead of being copied
+    void clear()
+    {
+        if (m_Buffer && m_Buffer->refs.load(std::memory_order_acquire) == 1)
+            m_Buffer->elements.clear();
+        else
+            unref(std::exchange(m_Buffer, nullptr));
+    }
+
+    // indices are checked before a shared buffer is copied
+    void remove(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        write([&](Elements& elements) { elements.remove(index); });
+    }
+
+    void insert(const std::size_t& index, const T& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        write([&](Elements& elements) { elements.insert(index, item); });
+    }
+
+    void insert(const std::size_t& index, T&& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        write([&](Elements& elements) { elements.insert(index, std::move(item)); });
+    }
+
+    void pop_back()
+    {
+        write([](Elements& elements) { elements.pop_back(); });
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        write([&](Elements& elements) { elements.emplace_back(std::forward<Args>(args)...); });
+    }
+
+    // how many vectors share this buffer, 0 while empty
+    std::size_t use_count() const
+    {
+        return m_Buffer ? m_Buffer->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    T* data()
+    {
+        if (!m_Buffer)
+            return nullptr;
+        return write([](Elements& elements) { return elements.data(); });
+    }
+
+    const T* data() const
+    {
+        return m_Buffer ? m_Buffer->elements.data() : nullptr;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(data());
+    }
+
+    Iterator end()
+    {
+        return Iterator(data() + size());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    const T& front() const
+    {
+        return at(0);
+    }
+
+    const T& back() const
+    {
+        return at(size() - 1);
+    }
+
+    T& front()
+    {
+        return at(0);
+    }
+
+    T& back()
+    {
+        return at(size() - 1);
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Buffer ? m_Buffer->elements.size() : 0;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_Buffer ? m_Buffer->elements.capacity() : 0;
+    }
+};
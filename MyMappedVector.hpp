@@ -0,0 +1,414 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "GrowthPolicy.hpp"
+#include "MyVector.hpp"
+
+enum class MapMode
+{
+    ReadWrite, // open or create the file, changes are written back to it
+    ReadOnly   // map an existing file without copying it, the size is fixed
+};
+
+// Vector of trivially copyable records stored in a file through a shared
+// mapping. Opening maps the file, so loading a saved array costs no copy and
+// pages come in on first touch. The file is just the records back to back.
+//
+// Growing extends the file with ftruncate and the mapping with mremap. While
+// open the file is as long as capacity(); it is cut back to size() when the
+// vector is closed, so after a crash it may end in unused records.
+//
+// Writing to an element of a ReadOnly vector faults, and every call that
+// changes its size throws std::logic_error.
+template <typename T, typename GrowthPolicy = PageRoundedGrowth<>>
+class MyMappedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "mapped elements must be trivially copyable");
+
+private:
+    int m_File = -1;
+    bool m_ReadOnly = false;
+    std::size_t m_Size = 0;
+    std::size_t m_Capacity = 0;
+    T* m_Array = nullptr;
+
+public:
+    using ValueType = T;
+    using Policy = GrowthPolicy;
+    using Iterator = MyVectorIterator<MyMappedVector>;
+    using ConstIterator = MyVectorIterator<MyMappedVector, true>;
+
+private:
+    [[noreturn]] static void fail(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void requireWritable() const
+    {
+        if (m_ReadOnly)
+            throw std::logic_error("vector is read-only");
+    }
+
+    void* map(std::size_t bytes)
+    {
+        int protection = m_ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = mmap(nullptr, bytes, protection, MAP_SHARED, m_File, 0);
+        if (p == MAP_FAILED)
+            fail("mmap");
+        return p;
+    }
+
+    // resize the mapping in place or move it, the file must already be long enough
+    void remap(std::size_t oldBytes, std::size_t newBytes)
+    {
+        if (newBytes == 0)
+        {
+            munmap(m_Array, oldBytes);
+            m_Array = nullptr;
+            return;
+        }
+        if (!m_Array)
+        {
+            m_Array = static_cast<T*>(map(newBytes));
+            return;
+        }
+#ifdef __linux__
+        void* p = mremap(m_Array, oldBytes, newBytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+            fail("mremap");
+        m_Array = static_cast<T*>(p);
+#else
+        // the data lives in the file, so a fresh mapping sees it
+        void* p = map(newBytes);
+        munmap(m_Array, oldBytes);
+        m_Array = static_cast<T*>(p);
+#endif
+    }
+
+    // set the capacity, extending or cutting the file to match
+    void reallocate(std::size_t cap)
+    {
+        requireWritable();
+        if (capacity() == cap)
+            return;
+
+        std::size_t oldBytes = capacity() * sizeof(T);
+        std::size_t newBytes = cap * sizeof(T);
+        // the file must cover the whole mapping, touching a page past its end is SIGBUS
+        if (newBytes > oldBytes && ftruncate(m_File, newBytes) != 0)
+            fail("ftruncate");
+        remap(oldBytes, newBytes);
+        if (newBytes < oldBytes && ftruncate(m_File, newBytes) != 0)
+            fail("ftruncate");
+
+        m_Capacity = cap;
+        if (size() > cap)
+            m_Size = cap;
+    }
+
+    void grow(std::size_t required)
+    {
+        reallocate(GrowthPolicy::grow(capacity(), required, sizeof(T)));
+    }
+
+    void close()
+    {
+        if (m_Array)
+            munmap(m_Array, capacity() * sizeof(T));
+        if (m_File >= 0)
+        {
+            // drop the unused capacity so the file holds exactly the elements
+            if (!m_ReadOnly)
+                (void)ftruncate(m_File, size() * sizeof(T));
+            ::close(m_File);
+        }
+        m_File = -1;
+        m_Array = nullptr;
+        m_Size = m_Capacity = 0;
+    }
+
+public:
+    // open path, creating it for ReadWrite; its length must be a whole number of records
+    explicit MyMappedVector(const std::string& path, MapMode mode = MapMode::ReadWrite)
+        : m_ReadOnly(mode == MapMode::ReadOnly)
+    {
+        m_File = m_ReadOnly ? open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                            : open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_File < 0)
+            fail("open " + path);
+
+        struct stat info;
+        if (fstat(m_File, &info) != 0)
+        {
+            ::close(m_File);
+            fail("fstat " + path);
+        }
+        std::size_t bytes = info.st_size;
+        if (bytes % sizeof(T) != 0)
+        {
+            ::close(m_File);
+            throw std::invalid_argument(path + " does not hold a whole number of elements");
+        }
+
+        if (bytes)
+        {
+            try
+            {
+                m_Array = static_cast<T*>(map(bytes));
+            }
+            catch (...)
+            {
+                ::close(m_File);
+                throw;
+            }
+        }
+        m_Size = m_Capacity = bytes / sizeof(T);
+    }
+
+    MyMappedVector(const MyMappedVector&) = delete;
+    MyMappedVector& operator=(const MyMappedVector&) = delete;
+
+    MyMappedVector(MyMappedVector&& array) noexcept
+        : m_File(array.m_File),
+        m_ReadOnly(array.m_ReadOnly),
+        m_Size(array.m_Size),
+        m_Capacity(array.m_Capacity),
+        m_Array(array.m_Array)
+    {
+        array.m_File = -1;
+        array.m_Array = nullptr;
+        array.m_Size = array.m_Capacity = 0;
+    }
+
+    // unmaps and closes this vector's file first, trimming it to size()
+    MyMappedVector& operator=(MyMappedVector&& array) noexcept
+    {
+        if (this != &array)
+        {
+            close();
+            m_File = std::exchange(array.m_File, -1);
+            m_ReadOnly = array.m_ReadOnly;
+            m_Size = std::exchange(array.m_Size, 0);
+            m_Capacity = std::exchange(array.m_Capacity, 0);
+            m_Array = std::exchange(array.m_Array, nullptr);
+        }
+        return *this;
+    }
+
+    ~MyMappedVector()
+    {
+        close();
+    }
+
+    T& operator[](const std::size_t& index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return data()[index];
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    T& at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    // make room for n elements without changing the size
+    void reserve(const std::size_t& n)
+    {
+        requireWritable();
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    // set the size to n, new elements are value-initialized
+    void resize(const std::size_t& n)
+    {
+        resize(n, T());
+    }
+
+    // set the size to n, new elements are copies of value
+    void resize(const std::size_t& n, const T& value)
+    {
+        requireWritable();
+        T item = value; // value may live in the mapping that grow() moves
+        if (n > capacity())
+            grow(n);
+        for (; m_Size < n; ++m_Size)
+            m_Array[m_Size] = item;
+        m_Size = n;
+    }
+
+    void shrinkToFit()
+    {
+        reallocate(size());
+    }
+
+    void clear()
+    {
+        requireWritable();
+        m_Size = 0;
+    }
+
+    // write dirty pages back to the file; async only schedules the write
+    void flush(bool async = false)
+    {
+        if (m_ReadOnly || !m_Array)
+            return;
+        if (msync(m_Array, capacity() * sizeof(T), async ? MS_ASYNC : MS_SYNC) != 0)
+            fail("msync");
+    }
+
+    void remove(const std::size_t& index)
+    {
+        requireWritable();
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        std::memmove(static_cast<void*>(m_Array + index), m_Array + index + 1, (size() - index - 1) * sizeof(T));
+        --m_Size;
+    }
+
+    void insert(const std::size_t& index, const T& item)
+    {
+        requireWritable();
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        T value = item; // item may live in the mapping that grow() moves
+        if (size() == capacity())
+            grow(size() + 1);
+        std::memmove(static_cast<void*>(m_Array + index + 1), m_Array + index, (size() - index) * sizeof(T));
+        m_Array[index] = value;
+        ++m_Size;
+    }
+
+    // append count elements from items, which must not point into this vector
+    void append(const T* items, std::size_t count)
+    {
+        requireWritable();
+        if (size() + count > capacity())
+            grow(size() + count);
+        if (count)
+            std::memcpy(static_cast<void*>(m_Array + size()), items, count * sizeof(T));
+        m_Size += count;
+    }
+
+    void pop_back()
+    {
+        requireWritable();
+        --m_Size;
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        requireWritable();
+        T value(std::forward<Args>(args)...);
+        if (size() >= capacity())
+            grow(size() + 1);
+        m_Array[m_Size++] = value;
+    }
+
+    T* data()
+    {
+        return m_Array;
+    }
+
+    const T* data() const
+    {
+        return m_Array;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(data());
+    }
+
+    Iterator end()
+    {
+        return Iterator(data() + size());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    T& front()
+    {
+        return at(0);
+    }
+
+    T& back()
+    {
+        return at(size() - 1);
+    }
+
+    bool readOnly() const
+    {
+        return m_ReadOnly;
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Size;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_Capacity;
+    }
+};
@@ -0,0 +1,685 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Immutable vector whose versions share structure. push_back, set and
+// pop_back leave the vector as it is and return a new version that shares
+// every node it didn't change, so keeping a history of versions costs
+// O(log32 n) memory per change instead of a full copy.
+//
+// Elements live in the leaves of a trie of 32-way nodes, where each level
+// takes 5 bits of the index, plus a tail leaf holding the last 1-32
+// elements so most push_backs and pop_backs don't touch the trie at all.
+// Nodes are reference counted atomically and never change once shared, so
+// versions can be read and dropped from any thread.
+//
+// transient() returns a builder for bulk changes. It changes the nodes it
+// made itself in place instead of copying a path for every change. A builder
+// can be moved but not copied.
+template <typename T>
+class MyPersistentVector
+{
+public:
+    static constexpr std::size_t Bits = 5;
+    static constexpr std::size_t Width = std::size_t(1) << Bits;
+    static constexpr std::size_t Mask = Width - 1;
+
+private:
+    struct Node
+    {
+        std::atomic<std::size_t> refs{1};
+        std::uint64_t edit; // the transient that may change this node in place, 0 for none
+
+        explicit Node(std::uint64_t owner)
+            : edit(owner)
+        {
+        }
+    };
+
+    struct Branch : Node
+    {
+        Node* children[Width] = {};
+
+        using Node::Node;
+    };
+
+    // leaves in the trie are full, only the tail holds fewer elements
+    struct Leaf : Node
+    {
+        std::size_t count = 0;
+        alignas(T) unsigned char storage[Width * sizeof(T)];
+
+        using Node::Node;
+
+        ~Leaf()
+        {
+            std::destroy_n(values(), count);
+        }
+
+        T* values()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+
+        const T* values() const
+        {
+            return std::launder(reinterpret_cast<const T*>(storage));
+        }
+    };
+
+    std::size_t m_Size = 0;
+    std::size_t m_Shift = Bits; // index bits below the root's children
+    Node* m_Root = nullptr;     // null while the trie is empty
+    Node* m_Tail = nullptr;     // null while the vector is empty
+
+public:
+    using ValueType = T;
+
+    class ConstIterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = const T&;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        const MyPersistentVector* m_Vector = nullptr;
+        std::size_t m_Index = 0;
+        const T* m_Leaf = nullptr; // values of the leaf holding m_Index
+
+        void seek(std::size_t index)
+        {
+            m_Index = index;
+            m_Leaf = index < m_Vector->size() ? m_Vector->leafFor(index) : nullptr;
+        }
+
+    public:
+        ConstIterator()
+        {
+        }
+
+        ConstIterator(const MyPersistentVector* vector, std::size_t index)
+            : m_Vector(vector)
+        {
+            seek(index);
+        }
+
+        ConstIterator& operator++()
+        {
+            // only look the leaf up again when crossing into the next one
+            if ((++m_Index & Mask) == 0)
+                seek(m_Index);
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        ConstIterator& operator--()
+        {
+            seek(m_Index - 1);
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator temp = *this;
+            seek(m_Index - 1);
+            return temp;
+        }
+
+        ConstIterator& operator+=(difference_type n)
+        {
+            seek(m_Index + n);
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type n)
+        {
+            seek(m_Index - n);
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type n) const
+        {
+            return ConstIterator(m_Vector, m_Index + n);
+        }
+
+        friend ConstIterator operator+(difference_type n, const ConstIterator& it)
+        {
+            return it + n;
+        }
+
+        ConstIterator operator-(difference_type n) const
+        {
+            return ConstIterator(m_Vector, m_Index - n);
+        }
+
+        difference_type operator-(const ConstIterator& other) const
+        {
+            return difference_type(m_Index) - difference_type(other.m_Index);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return (*m_Vector)[m_Index + n];
+        }
+
+        reference operator*() const
+        {
+            return m_Leaf[m_Index & Mask];
+        }
+
+        pointer operator->() const
+        {
+            return m_Leaf + (m_Index & Mask);
+        }
+
+        bool operator==(const ConstIterator& other) const
+        {
+            return m_Index == other.m_Index;
+        }
+
+        bool operator!=(const ConstIterator& other) const
+        {
+            return m_Index != other.m_Index;
+        }
+
+        bool operator<(const ConstIterator& other) const
+        {
+            return m_Index < other.m_Index;
+        }
+
+        bool operator>(const ConstIterator& other) const
+        {
+            return m_Index > other.m_Index;
+        }
+
+        bool operator<=(const ConstIterator& other) const
+        {
+            return m_Index <= other.m_Index;
+        }
+
+        bool operator>=(const ConstIterator& other) const
+        {
+            return m_Index >= other.m_Index;
+        }
+    };
+
+    using Iterator = ConstIterator;
+
+    class Transient;
+
+private:
+    // every transient gets its own id, so nodes it made are never changed by another one
+    static std::uint64_t newEdit()
+    {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void retain(Node* node)
+    {
+        if (node)
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // drop one reference to a node `shift` bits above the leaves, freeing it when it was the last
+    static void release(Node* node, std::size_t shift)
+    {
+        if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        if (shift == 0)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        for (Node* child : branch->children)
+            release(child, shift - Bits);
+        delete branch;
+    }
+
+    static Node* copyNode(Node* from, std::size_t shift, std::uint64_t edit)
+    {
+        if (shift == 0)
+        {
+            const Leaf* leaf = static_cast<Leaf*>(from);
+            Leaf* copy = new Leaf(edit);
+            try
+            {
+                std::uninitialized_copy_n(leaf->values(), leaf->count, copy->values());
+            }
+            catch (...)
+            {
+                delete copy;
+                throw;
+            }
+            copy->count = leaf->count;
+            return copy;
+        }
+
+        Branch* copy = new Branch(edit);
+        for (std::size_t i = 0; i < Width; i++)
+        {
+            copy->children[i] = static_cast<Branch*>(from)->children[i];
+            retain(copy->children[i]);
+        }
+        return copy;
+    }
+
+    // The node in slot, ready to be changed: nodes made by the transient
+    // `edit` are changed in place, any other node is copied into slot first.
+    // edit 0 always copies, which is how versions are made.
+    static Node* own(Node*& slot, std::size_t shift, std::uint64_t edit)
+    {
+        if (edit != 0 && slot->edit == edit)
+            return slot;
+
+        Node* copy = copyNode(slot, shift, edit);
+        release(slot, shift);
+        slot = copy;
+        return copy;
+    }
+
+    // index of the first element in the tail
+    std::size_t tailOffset() const
+    {
+        return m_Size == 0 ? 0 : (m_Size - 1) & ~Mask;
+    }
+
+    // the leaf holding index, walking down from the root
+    Node* leafNode(std::size_t index) const
+    {
+        if (index >= tailOffset())
+            return m_Tail;
+
+        Node* node = m_Root;
+        for (std::size_t shift = m_Shift; shift > 0; shift -= Bits)
+            node = static_cast<Branch*>(node)->children[(index >> shift) & Mask];
+        return node;
+    }
+
+    const T* leafFor(std::size_t index) const
+    {
+        return static_cast<const Leaf*>(leafNode(index))->values();
+    }
+
+    // The operations below change this vector, copying the nodes on their
+    // path as own() decides. The public versions run them on a copy.
+
+    void pushBack(T&& value, std::uint64_t edit)
+    {
+        std::size_t inTail = m_Size - tailOffset();
+        if (m_Tail && inTail < Width)
+        {
+            Leaf* tail = static_cast<Leaf*>(own(m_Tail, 0, edit));
+            new(tail->values() + tail->count) T(std::move(value));
+            ++tail->count;
+            ++m_Size;
+            return;
+        }
+
+        Leaf* tail = new Leaf(edit);
+        try
+        {
+            new(tail->values()) T(std::move(value));
+            tail->count = 1;
+            if (m_Tail)
+                pushTail(edit);
+        }
+        catch (...)
+        {
+            delete tail;
+            throw;
+        }
+        m_Tail = tail;
+        ++m_Size;
+    }
+
+    // move the full tail into the trie, adding a level when the root is full
+    void pushTail(std::uint64_t edit)
+    {
+        std::size_t index = m_Size - Width; // first index of the tail
+        Branch* node;
+        if (!m_Root)
+        {
+            node = new Branch(edit);
+            m_Root = node;
+        }
+        else if ((index >> m_Shift) >= Width)
+        {
+            node = new Branch(edit);
+            node->children[0] = m_Root;
+            m_Root = node;
+            m_Shift += Bits;
+        }
+        else
+        {
+            node = static_cast<Branch*>(own(m_Root, m_Shift, edit));
+        }
+
+        for (std::size_t shift = m_Shift; shift > Bits; shift -= Bits)
+        {
+            Node*& child = node->children[(index >> shift) & Mask];
+            if (child)
+                own(child, shift - Bits, edit);
+            else
+                child = new Branch(edit);
+            node = static_cast<Branch*>(child);
+        }
+        node->children[(index >> Bits) & Mask] = m_Tail;
+    }
+
+    void assign(std::size_t index, T&& value, std::uint64_t edit)
+    {
+        Node** slot = &m_Tail;
+        if (index < tailOffset())
+        {
+            slot = &m_Root;
+            for (std::size_t shift = m_Shift; shift > 0; shift -= Bits)
+                slot = &static_cast<Branch*>(own(*slot, shift, edit))->children[(index >> shift) & Mask];
+        }
+        static_cast<Leaf*>(own(*slot, 0, edit))->values()[index & Mask] = std::move(value);
+    }
+
+    void popBack(std::uint64_t edit)
+    {
+        if (m_Size == 0)
+            throw std::out_of_range("vector is empty");
+
+        if (m_Size - tailOffset() > 1)
+        {
+            Leaf* tail = static_cast<Leaf*>(own(m_Tail, 0, edit));
+            std::destroy_at(tail->values() + --tail->count);
+            --m_Size;
+            return;
+        }
+
+        // the tail empties, the last leaf of the trie becomes the new tail
+        Node* leaf = m_Size > 1 ? leafNode(m_Size - 2) : nullptr;
+        retain(leaf);
+        if (leaf)
+            popLeaf(m_Root, m_Shift, m_Size - 2, edit);
+        release(m_Tail, 0);
+        m_Tail = leaf;
+        --m_Size;
+
+        // drop a root level that has only one child left
+        if (m_Shift > Bits && !static_cast<Branch*>(m_Root)->children[1])
+        {
+            Node* child = static_cast<Branch*>(m_Root)->children[0];
+            retain(child);
+            release(m_Root, m_Shift);
+            m_Root = child;
+            m_Shift -= Bits;
+        }
+    }
+
+    // remove the trie's last leaf, the one holding index; slot becomes null
+    // when that leaf was the only one below it
+    void popLeaf(Node*& slot, std::size_t shift, std::size_t index, std::uint64_t edit)
+    {
+        if ((index & ((Width << shift) - 1)) < Width)
+        {
+            release(slot, shift);
+            slot = nullptr;
+            return;
+        }
+
+        Branch* node = static_cast<Branch*>(own(slot, shift, edit));
+        Node*& child = node->children[(index >> shift) & Mask];
+        if (shift == Bits)
+        {
+            release(child, 0);
+            child = nullptr;
+        }
+        else
+        {
+            popLeaf(child, shift - Bits, index, edit);
+        }
+    }
+
+public:
+    MyPersistentVector()
+    {
+    }
+
+    MyPersistentVector(std::initializer_list<T> l)
+    {
+        Transient builder = transient();
+        for (const T& item : l)
+            builder.push_back(item);
+        *this = builder.persistent();
+    }
+
+    MyPersistentVector(const MyPersistentVector& array)
+        : m_Size(array.m_Size),
+        m_Shift(array.m_Shift),
+        m_Root(array.m_Root),
+        m_Tail(array.m_Tail)
+    {
+        retain(m_Root);
+        retain(m_Tail);
+    }
+
+    MyPersistentVector(MyPersistentVector&& array) noexcept
+        : m_Size(std::exchange(array.m_Size, 0)),
+        m_Shift(std::exchange(array.m_Shift, Bits)),
+        m_Root(std::exchange(array.m_Root, nullptr)),
+        m_Tail(std::exchange(array.m_Tail, nullptr))
+    {
+    }
+
+    MyPersistentVector& operator=(const MyPersistentVector& array)
+    {
+        if (this != &array)
+        {
+            MyPersistentVector copy(array);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    MyPersistentVector& operator=(MyPersistentVector&& array) noexcept
+    {
+        if (this != &array)
+        {
+            release(m_Root, m_Shift);
+            release(m_Tail, 0);
+            m_Size = std::exchange(array.m_Size, 0);
+            m_Shift = std::exchange(array.m_Shift, Bits);
+            m_Root = std::exchange(array.m_Root, nullptr);
+            m_Tail = std::exchange(array.m_Tail, nullptr);
+        }
+        return *this;
+    }
+
+    ~MyPersistentVector()
+    {
+        release(m_Root, m_Shift);
+        release(m_Tail, 0);
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return leafFor(index)[index & Mask];
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return (*this)[index];
+    }
+
+    // this vector with value appended
+    [[nodiscard]] MyPersistentVector push_back(T value) const
+    {
+        MyPersistentVector next(*this);
+        next.pushBack(std::move(value), 0);
+        return next;
+    }
+
+    // this vector with the element at index replaced by value
+    [[nodiscard]] MyPersistentVector set(const std::size_t& index, T value) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        MyPersistentVector next(*this);
+        next.assign(index, std::move(value), 0);
+        return next;
+    }
+
+    // this vector without its last element
+    [[nodiscard]] MyPersistentVector pop_back() const
+    {
+        MyPersistentVector next(*this);
+        next.popBack(0);
+        return next;
+    }
+
+    // a builder that starts from this vector
+    Transient transient() const
+    {
+        return Transient(*this);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const
+    {
+        return end();
+    }
+
+    const T& front() const
+    {
+        return at(0);
+    }
+
+    const T& back() const
+    {
+        return at(size() - 1);
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Size;
+    }
+};
+
+// Mutable view of a MyPersistentVector for bulk changes. Nodes it makes are
+// tagged with its id and changed in place from then on, so building n
+// elements copies no paths. persistent() hands out the current state and
+// takes a new id, which freezes every node made so far; the transient
+// stays usable and copies those nodes again if it changes them later.
+//
+// A transient must only be used by one thread at a time. If a change
+// throws, the transient is left valid but the change may be half done.
+template <typename T>
+class MyPersistentVector<T>::Transient
+{
+private:
+    MyPersistentVector m_Vector;
+    std::uint64_t m_Edit;
+
+public:
+    explicit Transient(const MyPersistentVector& from)
+        : m_Vector(from),
+        m_Edit(newEdit())
+    {
+    }
+
+    // a copy would share the edit id and change the other's nodes in place
+    Transient(const Transient&) = delete;
+    Transient& operator=(const Transient&) = delete;
+
+    // the source gets a fresh id, so it can't reach the nodes it handed over
+    Transient(Transient&& other) noexcept
+        : m_Vector(std::move(other.m_Vector)),
+        m_Edit(std::exchange(other.m_Edit, newEdit()))
+    {
+    }
+
+    Transient& operator=(Transient&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_Vector = std::move(other.m_Vector);
+            m_Edit = std::exchange(other.m_Edit, newEdit());
+        }
+        return *this;
+    }
+
+    Transient& push_back(T value)
+    {
+        m_Vector.pushBack(std::move(value), m_Edit);
+        return *this;
+    }
+
+    Transient& set(const std::size_t& index, T value)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        m_Vector.assign(index, std::move(value), m_Edit);
+        return *this;
+    }
+
+    Transient& pop_back()
+    {
+        m_Vector.popBack(m_Edit);
+        return *this;
+    }
+
+    MyPersistentVector persistent()
+    {
+        m_Edit = newEdit();
+        return m_Vector;
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return m_Vector[index];
+    }
+
+    std::size_t size() const
+    {
+        return m_Vector.size();
+    }
+};
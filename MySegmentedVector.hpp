@@ -0,0 +1,515 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Vector that stores its elements in chunks that double in size. Growing
+// allocates a new chunk instead of relocating, so an element never changes
+// address once written (insert and remove still shift values between slots)
+// and appends never pay an O(n) copy. Indexing stays O(1): chunk k holds
+// FirstChunk << k elements and starts at index FirstChunk * (2^k - 1).
+template <typename T, std::size_t FirstChunk = 16>
+class MySegmentedVector
+{
+    static_assert(std::has_single_bit(FirstChunk), "first chunk size must be a power of two");
+
+private:
+    static constexpr std::size_t FirstShift = std::countr_zero(FirstChunk);
+    static constexpr std::size_t MaxChunks = 64 - FirstShift;
+
+    std::size_t m_Size = 0;
+    std::size_t m_Chunks = 0;
+    T* m_Chunk[MaxChunks] = {};
+
+public:
+    using ValueType = T;
+
+    template<bool IsConst>
+    class SegmentIterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using element_type = std::conditional_t<IsConst, const T, T>;
+        using pointer = element_type*;
+        using reference = element_type&;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        using Vector = std::conditional_t<IsConst, const MySegmentedVector, MySegmentedVector>;
+
+        Vector* m_Vector = nullptr;
+        std::size_t m_Index = 0;
+        pointer m_Ptr = nullptr;
+        pointer m_ChunkEnd = nullptr;
+
+        void seek(std::size_t index)
+        {
+            m_Index = index;
+            std::size_t chunk = chunkOf(index);
+            if (chunk < m_Vector->m_Chunks)
+            {
+                m_Ptr = m_Vector->m_Chunk[chunk] + (index - chunkStart(chunk));
+                m_ChunkEnd = m_Vector->m_Chunk[chunk] + chunkSize(chunk);
+            }
+            else
+            {
+                m_Ptr = m_ChunkEnd = nullptr;
+            }
+        }
+
+    public:
+        SegmentIterator()
+        {
+        }
+
+        SegmentIterator(Vector* vector, std::size_t index)
+            : m_Vector(vector)
+        {
+            seek(index);
+        }
+
+        // a mutable iterator converts to a const one
+        template<bool WasConst>
+            requires (IsConst && !WasConst)
+        SegmentIterator(const SegmentIterator<WasConst>& other)
+            : SegmentIterator(other.m_Vector, other.m_Index)
+        {
+        }
+
+        SegmentIterator& operator++()
+        {
+            // stay inside the current chunk without recomputing it
+            if (++m_Ptr == m_ChunkEnd)
+                seek(m_Index + 1);
+            else
+                ++m_Index;
+            return *this;
+        }
+
+        SegmentIterator operator++(int)
+        {
+            SegmentIterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        SegmentIterator& operator--()
+        {
+            seek(m_Index - 1);
+            return *this;
+        }
+
+        SegmentIterator operator--(int)
+        {
+            SegmentIterator temp = *this;
+            seek(m_Index - 1);
+            return temp;
+        }
+
+        SegmentIterator& operator+=(difference_type n)
+        {
+            seek(m_Index + n);
+            return *this;
+        }
+
+        SegmentIterator& operator-=(difference_type n)
+        {
+            seek(m_Index - n);
+            return *this;
+        }
+
+        SegmentIterator operator+(difference_type n) const
+        {
+            return SegmentIterator(m_Vector, m_Index + n);
+        }
+
+        friend SegmentIterator operator+(difference_type n, const SegmentIterator& it)
+        {
+            return it + n;
+        }
+
+        SegmentIterator operator-(difference_type n) const
+        {
+            return SegmentIterator(m_Vector, m_Index - n);
+        }
+
+        difference_type operator-(const SegmentIterator& other) const
+        {
+            return difference_type(m_Index) - difference_type(other.m_Index);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return (*m_Vector)[m_Index + n];
+        }
+
+        reference operator*() const
+        {
+            return *m_Ptr;
+        }
+
+        pointer operator->() const
+        {
+            return m_Ptr;
+        }
+
+        bool operator==(const SegmentIterator& other) const
+        {
+            return m_Index == other.m_Index;
+        }
+
+        bool operator!=(const SegmentIterator& other) const
+        {
+            return m_Index != other.m_Index;
+        }
+
+        bool operator<(const SegmentIterator& other) const
+        {
+            return m_Index < other.m_Index;
+        }
+
+        bool operator>(const SegmentIterator& other) const
+        {
+            return m_Index > other.m_Index;
+        }
+
+        bool operator<=(const SegmentIterator& other) const
+        {
+            return m_Index <= other.m_Index;
+        }
+
+        bool operator>=(const SegmentIterator& other) const
+        {
+            return m_Index >= other.m_Index;
+        }
+
+        template<bool>
+        friend class SegmentIterator;
+    };
+
+    using Iterator = SegmentIterator<false>;
+    using ConstIterator = SegmentIterator<true>;
+
+private:
+    static std::size_t chunkOf(std::size_t index)
+    {
+        return std::bit_width((index >> FirstShift) + 1) - 1;
+    }
+
+    static std::size_t chunkStart(std::size_t chunk)
+    {
+        return ((std::size_t(1) << chunk) - 1) << FirstShift;
+    }
+
+    static std::size_t chunkSize(std::size_t chunk)
+    {
+        return FirstChunk << chunk;
+    }
+
+    T* slot(std::size_t index) const
+    {
+        std::size_t chunk = chunkOf(index);
+        return m_Chunk[chunk] + (index - chunkStart(chunk));
+    }
+
+    void destroy(std::size_t from, std::size_t to)
+    {
+        for (std::size_t i = from; i < to; i++)
+            slot(i)->~T();
+    }
+
+    // allocate chunks until `count` elements fit
+    void addChunks(std::size_t count)
+    {
+        while (capacity() < count)
+        {
+            m_Chunk[m_Chunks] = static_cast<T*>(::operator new(chunkSize(m_Chunks) * sizeof(T)));
+            ++m_Chunks;
+        }
+    }
+
+    // free chunks that hold no element
+    void freeChunks()
+    {
+        while (m_Chunks > 0 && chunkStart(m_Chunks - 1) >= size())
+        {
+            --m_Chunks;
+            ::operator delete(m_Chunk[m_Chunks]);
+            m_Chunk[m_Chunks] = nullptr;
+        }
+    }
+
+    // Fill an empty vector from a range. A constructor that exits by throwing
+    // never runs the destructor, so a throwing copy frees what was built.
+    template<typename It>
+    void copyFrom(It first, It last, std::size_t count)
+    {
+        try
+        {
+            addChunks(count);
+            for (; first != last; ++first)
+            {
+                new(slot(m_Size)) T(*first);
+                ++m_Size;
+            }
+        }
+        catch (...)
+        {
+            hardClear();
+            throw;
+        }
+    }
+
+    // trade chunks with other, no element is touched
+    void swapChunks(MySegmentedVector& other)
+    {
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_Chunks, other.m_Chunks);
+        std::swap(m_Chunk, other.m_Chunk);
+    }
+
+public:
+    MySegmentedVector()
+    {
+    }
+
+    MySegmentedVector(std::initializer_list<T> l)
+    {
+        copyFrom(l.begin(), l.end(), l.size());
+    }
+
+    MySegmentedVector(const MySegmentedVector& array)
+    {
+        copyFrom(array.begin(), array.end(), array.size());
+    }
+
+    // chunks are handed over, no element is touched
+    MySegmentedVector(MySegmentedVector&& array) noexcept
+        : m_Size(array.m_Size),
+        m_Chunks(array.m_Chunks)
+    {
+        for (std::size_t i = 0; i < m_Chunks; i++)
+        {
+            m_Chunk[i] = array.m_Chunk[i];
+            array.m_Chunk[i] = nullptr;
+        }
+        array.m_Size = 0;
+        array.m_Chunks = 0;
+    }
+
+    MySegmentedVector& operator=(MySegmentedVector&& array) noexcept
+    {
+        MySegmentedVector moved(std::move(array));
+        swapChunks(moved);
+        return *this;
+    }
+
+    // a throwing copy leaves this vector untouched
+    MySegmentedVector& operator=(const MySegmentedVector& array)
+    {
+        MySegmentedVector copy(array);
+        swapChunks(copy);
+        return *this;
+    }
+
+    ~MySegmentedVector()
+    {
+        hardClear();
+    }
+
+    T& operator[](const std::size_t& index)
+    {
+        return *slot(index);
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return *slot(index);
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return *slot(index);
+    }
+
+    T& at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return *slot(index);
+    }
+
+    // make room for n elements, existing elements stay where they are
+    void reserve(const std::size_t& n)
+    {
+        addChunks(n);
+    }
+
+    // set the size to n, new elements are value-initialized
+    void resize(const std::size_t& n)
+    {
+        while (size() > n)
+            pop_back();
+        addChunks(n);
+        for (; m_Size < n; ++m_Size)
+            new(slot(m_Size)) T();
+    }
+
+    // set the size to n, new elements are copies of value; elements never
+    // move, so value may be one of them
+    void resize(const std::size_t& n, const T& value)
+    {
+        while (size() > n)
+            pop_back();
+        addChunks(n);
+        for (; m_Size < n; ++m_Size)
+            new(slot(m_Size)) T(value);
+    }
+
+    // release chunks past the last element
+    void shrinkToFit()
+    {
+        freeChunks();
+    }
+
+    void softClear()
+    {
+        destroy(0, size());
+        m_Size = 0;
+    }
+
+    void hardClear()
+    {
+        softClear();
+        freeChunks();
+    }
+
+    void clear()
+    {
+        softClear();
+    }
+
+    // remove element at index then shift the values after it down
+    void remove(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        for (std::size_t i = index, end = size() - 1; i < end; ++i)
+            *slot(i) = std::move(*slot(i + 1));
+        pop_back();
+    }
+
+    void insert(const std::size_t& index, const T& item)
+    {
+        insert(index, T(item));
+    }
+
+    void insert(const std::size_t& index, T&& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        if (index == size())
+        {
+            emplace_back(std::move(item));
+            return;
+        }
+
+        emplace_back(std::move(back()));
+        for (std::size_t i = size() - 2; i > index; --i)
+            *slot(i) = std::move(*slot(i - 1));
+        *slot(index) = std::move(item);
+    }
+
+    void pop_back()
+    {
+        slot(--m_Size)->~T();
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    // growing adds a chunk, so args may safely refer to an existing element
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (size() == capacity())
+            addChunks(size() + 1);
+        new(slot(m_Size)) T(std::forward<Args>(args)...);
+        ++m_Size;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end()
+    {
+        return Iterator(this, size());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    T& front()
+    {
+        return at(0);
+    }
+
+    T& back()
+    {
+        return at(size() - 1);
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Size;
+    }
+
+    std::size_t capacity() const
+    {
+        return chunkStart(m_Chunks);
+    }
+};
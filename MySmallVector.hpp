@@ -0,0 +1,436 @@
+#pragma once
+
+#include "MyVector.hpp"
+
+// Vector that keeps its first N elements inside the object and only
+// allocates once it grows past N. Same interface as MyVector.
+template <typename T, std::size_t N, typename GrowthPolicy = GeometricGrowth<>>
+class MySmallVector
+{
+    static_assert(N > 0, "inline capacity must be positive");
+
+private:
+    std::size_t m_Size = 0;
+    std::size_t m_Capacity = N;
+    T* m_Array = inlineData();
+    alignas(T) unsigned char m_Inline[N * sizeof(T)];
+
+public:
+    using ValueType = T;
+    using Policy = GrowthPolicy;
+    using Iterator = MyVectorIterator<MySmallVector>;
+    using ConstIterator = MyVectorIterator<MySmallVector, true>;
+
+private:
+    T* inlineData()
+    {
+        return reinterpret_cast<T*>(m_Inline);
+    }
+
+    // relocating never throws when it is a memcpy or a noexcept move
+    static constexpr bool MovesNothrow = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    // Move-construct count elements into raw memory and end the old ones'
+    // lifetime. The sources are only destroyed once every element arrived, so
+    // a throw leaves them all in place and nothing behind in `to`; elements
+    // whose move can throw are copied when they can be, and then nothing
+    // changes at all.
+    static void relocate(T* const from, T* const to, std::size_t count)
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (count)
+                std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+        }
+        else
+        {
+            std::size_t built = 0;
+            try
+            {
+                for (; built < count; built++)
+                    new(to + built) T(std::move_if_noexcept(from[built]));
+            }
+            catch (...)
+            {
+                std::destroy_n(to, built);
+                throw;
+            }
+            std::destroy_n(from, count);
+        }
+    }
+
+    void destroy(std::size_t from, std::size_t to)
+    {
+        for (std::size_t i = from; i < to; i++)
+            m_Array[i].~T();
+    }
+
+    void freeHeap()
+    {
+        if (!isInline())
+            ::operator delete(m_Array);
+    }
+
+    // end the elements past n
+    void truncate(std::size_t n)
+    {
+        destroy(n, size());
+        m_Size = n;
+    }
+
+    // capacity never drops below N, shrinking to N moves the elements back inline
+    void reallocate(std::size_t cap)
+    {
+        if (size() > cap)
+            truncate(cap);
+
+        std::size_t newCap = std::max(cap, N);
+        if (capacity() == newCap)
+            return;
+
+        T* newArray = newCap == N ? inlineData() : static_cast<T*>(::operator new(newCap * sizeof(T)));
+        try
+        {
+            relocate(m_Array, newArray, size());
+        }
+        catch (...)
+        {
+            if (newArray != inlineData())
+                ::operator delete(newArray);
+            throw;
+        }
+        freeHeap();
+        m_Array = newArray;
+        m_Capacity = newCap;
+    }
+
+    // make room for at least `required` elements using the growth policy
+    void grow(std::size_t required)
+    {
+        reallocate(GrowthPolicy::grow(capacity(), required, sizeof(T)));
+    }
+
+    // Fill an empty vector from a range. A constructor that exits by throwing
+    // never runs the destructor, so a throwing copy frees what was built.
+    template<typename It>
+    void copyFrom(It first, It last, std::size_t count)
+    {
+        try
+        {
+            reserve(count);
+            for (; first != last; ++first)
+            {
+                new(&m_Array[m_Size]) T(*first);
+                ++m_Size;
+            }
+        }
+        catch (...)
+        {
+            hardClear();
+            throw;
+        }
+    }
+
+    // take over other's elements, other is left empty and inline
+    void steal(MySmallVector& other)
+    {
+        if (other.isInline())
+        {
+            relocate(other.m_Array, m_Array, other.size());
+        }
+        else
+        {
+            m_Array = other.m_Array;
+            m_Capacity = other.m_Capacity;
+            other.m_Array = other.inlineData();
+            other.m_Capacity = N;
+        }
+        m_Size = other.m_Size;
+        other.m_Size = 0;
+    }
+
+public:
+    MySmallVector()
+    {
+    }
+
+    MySmallVector(std::initializer_list<T> l)
+    {
+        copyFrom(l.begin(), l.end(), l.size());
+    }
+
+    MySmallVector(const MySmallVector& array)
+    {
+        copyFrom(array.begin(), array.end(), array.size());
+    }
+
+    // inline elements are moved one by one, a heap buffer is handed over
+    MySmallVector(MySmallVector&& array) noexcept(MovesNothrow)
+    {
+        steal(array);
+    }
+
+    MySmallVector& operator=(const MySmallVector& array)
+    {
+        if (this != &array)
+        {
+            MySmallVector copy(array);
+            hardClear();
+            steal(copy);
+        }
+        return *this;
+    }
+
+    MySmallVector& operator=(MySmallVector&& array) noexcept(MovesNothrow)
+    {
+        if (this != &array)
+        {
+            hardClear();
+            steal(array);
+        }
+        return *this;
+    }
+
+    ~MySmallVector()
+    {
+        destroy(0, size());
+        freeHeap();
+    }
+
+    T& operator[](const std::size_t& index)
+    {
+        return data()[index];
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    T& at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return data()[index];
+    }
+
+    // make room for n elements without changing the size
+    void reserve(const std::size_t& n)
+    {
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    // set the size to n, new elements are value-initialized
+    void resize(const std::size_t& n)
+    {
+        if (n <= size())
+        {
+            truncate(n);
+            return;
+        }
+        if (n > capacity())
+            grow(n);
+        for (; m_Size < n; ++m_Size)
+            new(&m_Array[m_Size]) T();
+    }
+
+    // set the size to n, new elements are copies of value
+    void resize(const std::size_t& n, const T& value)
+    {
+        if (n <= size())
+        {
+            truncate(n);
+            return;
+        }
+        T item(value); // value may live in the buffer that grow() moves
+        if (n > capacity())
+            grow(n);
+        for (; m_Size < n; ++m_Size)
+            new(&m_Array[m_Size]) T(item);
+    }
+
+    // shrink capacity to size
+    void shrinkToFit()
+    {
+        reallocate(size());
+    }
+
+    void softClear()
+    {
+        destroy(0, size());
+        m_Size = 0;
+    }
+
+    void hardClear()
+    {
+        reallocate(0);
+    }
+
+    void clear()
+    {
+        softClear();
+    }
+
+    // remove element at index then shift items in array down
+    void remove(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            m_Array[index].~T();
+            std::memmove(static_cast<void*>(m_Array + index), m_Array + index + 1, (size() - index - 1) * sizeof(T));
+        }
+        else
+        {
+            for (std::size_t i = index, end = size() - 1; i < end; ++i)
+                m_Array[i] = std::move(m_Array[i + 1]);
+            m_Array[size() - 1].~T();
+        }
+        --m_Size;
+    }
+
+    void insert(const std::size_t& index, const T& item)
+    {
+        insert(index, T(item));
+    }
+
+    void insert(const std::size_t& index, T&& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        if (size() == capacity())
+            grow(size() + 1);
+
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::memmove(static_cast<void*>(m_Array + index + 1), m_Array + index, (size() - index) * sizeof(T));
+            new(&m_Array[index]) T(std::move(item));
+        }
+        else if (index == size())
+        {
+            new(&m_Array[index]) T(std::move(item));
+        }
+        else
+        {
+            new(&m_Array[size()]) T(std::move(m_Array[size() - 1]));
+            ++m_Size;
+            for (std::size_t i = size() - 2; i > index; --i)
+                m_Array[i] = std::move(m_Array[i - 1]);
+            m_Array[index] = std::move(item);
+            return;
+        }
+        ++m_Size;
+    }
+
+    void pop_back()
+    {
+        m_Array[--m_Size].~T();
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (size() >= capacity())
+        {
+            // args may refer into the buffer that is about to move
+            T item(std::forward<Args>(args)...);
+            grow(size() + 1);
+            new(&m_Array[size()]) T(std::move(item));
+        }
+        else
+        {
+            new(&m_Array[size()]) T(std::forward<Args>(args)...);
+        }
+        ++m_Size;
+    }
+
+    // pointer to the array that is storing the data
+    T* data()
+    {
+        return m_Array;
+    }
+
+    const T* data() const
+    {
+        return m_Array;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(data());
+    }
+
+    Iterator end()
+    {
+        return Iterator(data() + size());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(data());
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(data() + size());
+    }
+
+    T& front()
+    {
+        return at(0);
+    }
+
+    T& back()
+    {
+        return at(size() - 1);
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    // true while the elements live inside the object
+    bool isInline() const
+    {
+        return m_Array == reinterpret_cast<const T*>(m_Inline);
+    }
+
+    std::size_t size() const
+    {
+        return m_Size;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_Capacity;
+    }
+};
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "MyVector.hpp"
+
+// Struct-of-arrays container: each field of a row lives in its own MyVector
+// column, so a scan over one field only pulls that field through the cache.
+// Rows are read and written through tuples of references.
+//
+//     MySoAVector<double, int> prices;
+//     prices.push_back({9.5, 3});
+//     for (double p : prices.column<0>()) ...
+template <typename... Fields>
+class MySoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "need at least one field");
+
+private:
+    std::tuple<MyVector<Fields>...> m_Columns;
+
+    static constexpr auto Indices = std::index_sequence_for<Fields...>{};
+
+public:
+    using ValueType = std::tuple<Fields...>;
+    using Row = std::tuple<Fields&...>;
+    using ConstRow = std::tuple<const Fields&...>;
+
+    template<std::size_t I>
+    using FieldType = std::tuple_element_t<I, ValueType>;
+
+    // Iterator over rows that dereferences to a Row proxy, so the legacy
+    // category is only input. The mutable iterator models
+    // std::random_access_iterator; the const one only claims input, as tuples
+    // of const references have no common_reference with ValueType before C++23.
+    template<bool IsConst>
+    class RowIterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueType;
+        using reference = std::conditional_t<IsConst, ConstRow, Row>;
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::conditional_t<IsConst, std::input_iterator_tag, std::random_access_iterator_tag>;
+
+    private:
+        using Vector = std::conditional_t<IsConst, const MySoAVector, MySoAVector>;
+
+        Vector* m_Vector = nullptr;
+        std::size_t m_Index = 0;
+
+    public:
+        RowIterator()
+        {
+        }
+
+        RowIterator(Vector* vector, std::size_t index)
+            : m_Vector(vector),
+            m_Index(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return m_Vector->row(m_Index);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return m_Vector->row(m_Index + n);
+        }
+
+        RowIterator& operator++()
+        {
+            m_Index++;
+            return *this;
+        }
+
+        RowIterator operator++(int)
+        {
+            RowIterator temp = *this;
+            m_Index++;
+            return temp;
+        }
+
+        RowIterator& operator--()
+        {
+            m_Index--;
+            return *this;
+        }
+
+        RowIterator operator--(int)
+        {
+            RowIterator temp = *this;
+            m_Index--;
+            return temp;
+        }
+
+        RowIterator& operator+=(difference_type n)
+        {
+            m_Index += n;
+            return *this;
+        }
+
+        RowIterator& operator-=(difference_type n)
+        {
+            m_Index -= n;
+            return *this;
+        }
+
+        RowIterator operator+(difference_type n) const
+        {
+            return RowIterator(m_Vector, m_Index + n);
+        }
+
+        friend RowIterator operator+(difference_type n, const RowIterator& it)
+        {
+            return it + n;
+        }
+
+        RowIterator operator-(difference_type n) const
+        {
+            return RowIterator(m_Vector, m_Index - n);
+        }
+
+        difference_type operator-(const RowIterator& other) const
+        {
+            return difference_type(m_Index) - difference_type(other.m_Index);
+        }
+
+        bool operator==(const RowIterator& other) const
+        {
+            return m_Index == other.m_Index;
+        }
+
+        bool operator!=(const RowIterator& other) const
+        {
+            return m_Index != other.m_Index;
+        }
+
+        bool operator<(const RowIterator& other) const
+        {
+            return m_Index < other.m_Index;
+        }
+
+        bool operator>(const RowIterator& other) const
+        {
+            return m_Index > other.m_Index;
+        }
+
+        bool operator<=(const RowIterator& other) const
+        {
+            return m_Index <= other.m_Index;
+        }
+
+        bool operator>=(const RowIterator& other) const
+        {
+            return m_Index >= other.m_Index;
+        }
+    };
+
+    using Iterator = RowIterator<false>;
+    using ConstIterator = RowIterator<true>;
+
+private:
+    template<typename Fn>
+    void forEachColumn(Fn&& fn)
+    {
+        std::apply([&](auto&... column) { (fn(column), ...); }, m_Columns);
+    }
+
+    // grow every column up front, so filling in a row can only fail in a field's constructor
+    void reserveRow()
+    {
+        forEachColumn([](auto& column) {
+            using Column = std::remove_reference_t<decltype(column)>;
+            if (column.size() == column.capacity())
+                column.reserve(Column::Policy::grow(column.capacity(), column.size() + 1, sizeof(typename Column::ValueType)));
+        });
+    }
+
+    // A field that throws undoes the columns already written, so the
+    // columns never end up with different lengths.
+    template<typename Tuple, std::size_t... I>
+    void pushRow(Tuple&& row, std::index_sequence<I...>)
+    {
+        reserveRow();
+        std::size_t done = 0;
+        try
+        {
+            ((std::get<I>(m_Columns).push_back(std::get<I>(std::forward<Tuple>(row))), ++done), ...);
+        }
+        catch (...)
+        {
+            ((I < done ? std::get<I>(m_Columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    template<typename Tuple, std::size_t... I>
+    void insertRow(std::size_t index, Tuple&& row, std::index_sequence<I...>)
+    {
+        reserveRow();
+        std::size_t done = 0;
+        try
+        {
+            ((std::get<I>(m_Columns).insert(index, std::get<I>(std::forward<Tuple>(row))), ++done), ...);
+        }
+        catch (...)
+        {
+            ((I < done ? std::get<I>(m_Columns).remove(index) : void()), ...);
+            throw;
+        }
+    }
+
+    template<std::size_t... I>
+    Row makeRow(std::size_t index, std::index_sequence<I...>)
+    {
+        return Row(std::get<I>(m_Columns)[index]...);
+    }
+
+    template<std::size_t... I>
+    ConstRow makeRow(std::size_t index, std::index_sequence<I...>) const
+    {
+        return ConstRow(std::get<I>(m_Columns).data()[index]...);
+    }
+
+public:
+    MySoAVector()
+    {
+    }
+
+    // one contiguous column per field
+    template<std::size_t I>
+    std::span<FieldType<I>> column()
+    {
+        auto& c = std::get<I>(m_Columns);
+        return std::span<FieldType<I>>(c.data(), c.size());
+    }
+
+    template<std::size_t I>
+    std::span<const FieldType<I>> column() const
+    {
+        const auto& c = std::get<I>(m_Columns);
+        return std::span<const FieldType<I>>(c.data(), c.size());
+    }
+
+    Row row(const std::size_t& index)
+    {
+        return makeRow(index, Indices);
+    }
+
+    ConstRow row(const std::size_t& index) const
+    {
+        return makeRow(index, Indices);
+    }
+
+    Row operator[](const std::size_t& index)
+    {
+        return row(index);
+    }
+
+    ConstRow operator[](const std::size_t& index) const
+    {
+        return row(index);
+    }
+
+    ConstRow at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return row(index);
+    }
+
+    Row at(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return row(index);
+    }
+
+    void push_back(const ValueType& item)
+    {
+        pushRow(item, Indices);
+    }
+
+    void push_back(ValueType&& item)
+    {
+        pushRow(std::move(item), Indices);
+    }
+
+    void emplace_back(Fields... fields)
+    {
+        push_back(ValueType(std::move(fields)...));
+    }
+
+    void insert(const std::size_t& index, const ValueType& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        insertRow(index, item, Indices);
+    }
+
+    void insert(const std::size_t& index, ValueType&& item)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        insertRow(index, std::move(item), Indices);
+    }
+
+    void remove(const std::size_t& index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        forEachColumn([&](auto& column) { column.remove(index); });
+    }
+
+    void pop_back()
+    {
+        forEachColumn([](auto& column) { column.pop_back(); });
+    }
+
+    // make room for n rows in every column
+    void reserve(const std::size_t& n)
+    {
+        forEachColumn([&](auto& column) { column.reserve(n); });
+    }
+
+    // set the number of rows to n, new fields are value-initialized
+    void resize(const std::size_t& n)
+    {
+        forEachColumn([&](auto& column) { column.resize(n); });
+    }
+
+    void shrinkToFit()
+    {
+        forEachColumn([](auto& column) { column.shrinkToFit(); });
+    }
+
+    void clear()
+    {
+        forEachColumn([](auto& column) { column.clear(); });
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end()
+    {
+        return Iterator(this, size());
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    // every column has the same length
+    std::size_t size() const
+    {
+        return std::get<0>(m_Columns).size();
+    }
+
+    std::size_t capacity() const
+    {
+        return std::get<0>(m_Columns).capacity();
+    }
+};
@@ -1,23 +1,62 @@
-template<class MyVector>
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "GrowthPolicy.hpp"
+#include "MyVectorStats.hpp"
+#include "ReallocStorage.hpp"
+
+// A type is trivially relocatable when moving it to a new address and
+// forgetting the old one is the same as a memcpy. MyVector uses memcpy/memmove
+// for these. Trivially copyable types qualify automatically, other types can
+// opt in (or out) by specializing this trait:
+//
+//     template<> struct is_trivially_relocatable<MyType> : std::true_type {};
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Contiguous random-access iterator over a MyVector-like container's buffer.
+// IsConst selects the read-only variant returned by cbegin()/cend().
+template<class MyVector, bool IsConst = false>
 class MyVectorIterator
 {
 public:
     using difference_type = std::ptrdiff_t;
     using value_type = typename MyVector::ValueType;
-    using pointer = value_type*;
-    using reference = value_type&;
-    using iterator_category = std::output_iterator_tag;
+    using element_type = std::conditional_t<IsConst, const value_type, value_type>;
+    using pointer = element_type*;
+    using reference = element_type&;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::contiguous_iterator_tag;
 
 private:
     pointer m_Ptr;
 
 public:
-    MyVectorIterator(pointer ptr)
+    MyVectorIterator(pointer ptr = nullptr)
         : m_Ptr(ptr)
     {
     }
 
-    ~MyVectorIterator()
+    // a mutable iterator converts to a const one
+    template<bool WasConst>
+        requires (IsConst && !WasConst)
+    MyVectorIterator(const MyVectorIterator<MyVector, WasConst>& other)
+        : m_Ptr(other.operator->())
     {
     }
 
@@ -47,17 +86,49 @@ public:
         return temp; // return the old state
     }
 
-    reference operator[](int index)
+    MyVectorIterator& operator+=(difference_type n)
+    {
+        m_Ptr += n;
+        return *this;
+    }
+
+    MyVectorIterator& operator-=(difference_type n)
+    {
+        m_Ptr -= n;
+        return *this;
+    }
+
+    MyVectorIterator operator+(difference_type n) const
+    {
+        return MyVectorIterator(m_Ptr + n);
+    }
+
+    friend MyVectorIterator operator+(difference_type n, const MyVectorIterator& it)
+    {
+        return it + n;
+    }
+
+    MyVectorIterator operator-(difference_type n) const
+    {
+        return MyVectorIterator(m_Ptr - n);
+    }
+
+    difference_type operator-(const MyVectorIterator& other) const
+    {
+        return m_Ptr - other.m_Ptr;
+    }
+
+    reference operator[](difference_type index) const
     {
         return m_Ptr[index];
     }
 
-    pointer operator->()
+    pointer operator->() const
     {
         return m_Ptr;
     }
 
-    reference operator*()
+    reference operator*() const
     {
         return *(m_Ptr);
     }
@@ -71,67 +142,464 @@ public:
     {
         return m_Ptr != other.m_Ptr;
     }
+
+    bool operator<(const MyVectorIterator& other) const
+    {
+        return m_Ptr < other.m_Ptr;
+    }
+
+    bool operator>(const MyVectorIterator& other) const
+    {
+        return m_Ptr > other.m_Ptr;
+    }
+
+    bool operator<=(const MyVectorIterator& other) const
+    {
+        return m_Ptr <= other.m_Ptr;
+    }
+
+    bool operator>=(const MyVectorIterator& other) const
+    {
+        return m_Ptr >= other.m_Ptr;
+    }
 };
 
-template <typename T>
+template <typename T, typename GrowthPolicy = GeometricGrowth<>, typename Allocator = std::allocator<T>>
 class MyVector
 {
 private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    // only the default allocator can hand its buffers to realloc/mremap
+    static constexpr bool UsesReallocStorage = is_trivially_relocatable_v<T> && std::is_same_v<Allocator, std::allocator<T>>;
+
+    Allocator m_Allocator;
+    [[no_unique_address]] MyVectorStatsCounter<> m_Stats;
     std::size_t m_Size = 0;
     std::size_t m_Capacity;
     T* m_Array = nullptr;
 
 public:
     using ValueType = T;
-    using Iterator = MyVectorIterator<MyVector<T>>;
+    using Policy = GrowthPolicy;
+    using AllocatorType = Allocator;
+    using Iterator = MyVectorIterator<MyVector>;
+    using ConstIterator = MyVectorIterator<MyVector, true>;
 
 private:
+    // Elements [0, size()) are alive, [size(), capacity()) is raw memory.
+    // Elements are only ever created by placement construction into raw
+    // slots and end with a destructor call, never by assigning to raw memory.
+
+    // copy construct count elements into raw memory
     void copy(const T* const from, T* const to, std::size_t count)
     {
-        for (std::size_t i = 0; i < count; i++)
-            *(to + i) = *(from + i);
+        m_Stats.copied(count);
+        std::uninitialized_copy_n(from, count, to);
     }
 
+    // Moving is only used when it can't throw (or T can't be copied), like
+    // std::move_if_noexcept. Otherwise elements are copied, so a throw halfway
+    // leaves the originals as they were.
+    static constexpr bool MovesSafely = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+    // Move or copy count elements into raw memory, leaving the originals for
+    // the caller to end; trivially relocatable ones are memcpy'd and must not
+    // be ended. If this throws, the originals are untouched.
+    void transfer(T* const from, T* const to, std::size_t count)
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            m_Stats.moved(count);
+            if (count)
+                std::memcpy(static_cast<void*>(to), from, count * sizeof(T));
+        }
+        else if constexpr (MovesSafely)
+        {
+            m_Stats.moved(count);
+            std::uninitialized_move_n(from, count, to);
+        }
+        else
+        {
+            m_Stats.copied(count);
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    // relocate count elements into raw memory and end the originals
     void move(T* const from, T* const to, std::size_t count)
     {
-        for (std::size_t i = 0; i < count; i++)
-            *(to + i) = std::move(*(from + i));
+        transfer(from, to, count);
+        if constexpr (!is_trivially_relocatable_v<T>)
+            std::destroy_n(from, count);
+    }
+
+    // Build a new buffer holding the elements with `count` new ones at index,
+    // made by fill(gap), which must clean up after itself if it throws. The
+    // current buffer is untouched until everything is built, so this gives
+    // the strong guarantee, and fill may read elements of this vector.
+    template<typename Fill>
+    void rebuildWithGap(std::size_t index, std::size_t count, Fill fill)
+    {
+        std::size_t cap = size() + count > capacity() ? GrowthPolicy::grow(capacity(), size() + count, sizeof(T)) : capacity();
+        T* newArray = allocate(cap);
+        T* gap = newArray + index;
+        try
+        {
+            fill(gap);
+            try
+            {
+                transfer(m_Array, newArray, index);
+                try
+                {
+                    transfer(m_Array + index, gap + count, size() - index);
+                }
+                catch (...)
+                {
+                    std::destroy_n(newArray, index);
+                    throw;
+                }
+            }
+            catch (...)
+            {
+                std::destroy_n(gap, count);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            deallocate(newArray, cap);
+            throw;
+        }
+
+        // the old elements end only once the new buffer is complete
+        if constexpr (!is_trivially_relocatable_v<T>)
+            std::destroy_n(m_Array, size());
+        m_Stats.resized();
+        deallocate(m_Array, capacity());
+        m_Array = newArray;
+        m_Capacity = cap;
+        m_Size += count;
+    }
+
+    // Insert count elements made by fill(gap) before index. When neither
+    // filling nor shifting can throw, the elements are shifted in place;
+    // otherwise a new buffer is built so a throw changes nothing.
+    template<bool NothrowFill, typename Fill>
+    void insertGap(std::size_t index, std::size_t count, Fill fill)
+    {
+        constexpr bool NothrowShift = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+        if constexpr (NothrowFill && NothrowShift)
+        {
+            if (size() + count > capacity())
+                grow(size() + count);
+            shiftRight(index, count);
+            fill(m_Array + index);
+            m_Size += count;
+        }
+        else if (index == size() && size() + count <= capacity())
+        {
+            // nothing to shift, a throwing fill leaves the raw slots as they were
+            fill(m_Array + index);
+            m_Size += count;
+        }
+        else
+        {
+            rebuildWithGap(index, count, fill);
+        }
+    }
+
+    // Shift [index, size()) right by count slots, capacity must already fit
+    // them. Afterwards [index, index + count) is raw memory for the caller to
+    // construct into; size() is not changed.
+    void shiftRight(std::size_t index, std::size_t count = 1)
+    {
+        m_Stats.shifted(size() - index);
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::memmove(static_cast<void*>(m_Array + index + count), m_Array + index, (size() - index) * sizeof(T));
+        }
+        else
+        {
+            T* const end = m_Array + size();
+            if (size() - index > count)
+            {
+                // the last count elements move into raw memory, the rest over live ones
+                std::uninitialized_move(end - count, end, end);
+                std::move_backward(m_Array + index, end - count, end);
+                std::destroy_n(m_Array + index, count);
+            }
+            else
+            {
+                std::uninitialized_move(m_Array + index, end, m_Array + index + count);
+                std::destroy(m_Array + index, end);
+            }
+        }
+    }
+
+    // copy count elements starting at first to raw memory, one memcpy when possible
+    template<typename InputIt>
+    void copyRange(InputIt first, std::size_t count, T* const to)
+    {
+        m_Stats.copied(count);
+        if constexpr (std::is_trivially_copyable_v<T> && std::contiguous_iterator<InputIt>
+                      && std::is_same_v<std::iter_value_t<InputIt>, T>)
+        {
+            if (count)
+                std::memcpy(static_cast<void*>(to), std::to_address(first), count * sizeof(T));
+        }
+        else
+        {
+            std::uninitialized_copy_n(first, count, to);
+        }
+    }
+
+    template<typename It>
+    static constexpr bool IsForwardIterator = std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+    // shift (index, size()) left by one slot, ending the element at index;
+    // the caller drops the last slot from size()
+    void shiftLeft(std::size_t index)
+    {
+        m_Stats.shifted(size() - index - 1);
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::destroy_at(m_Array + index);
+            std::memmove(static_cast<void*>(m_Array + index), m_Array + index + 1, (size() - index - 1) * sizeof(T));
+        }
+        else
+        {
+            std::move(m_Array + index + 1, m_Array + size(), m_Array + index);
+            std::destroy_at(m_Array + size() - 1);
+        }
+    }
+
+    // count * sizeof(T) must not wrap, like std::allocator refuse what can't fit
+    void checkSize(std::size_t count) const
+    {
+        if (count > max_size())
+            throw std::length_error("MyVector is too large");
+    }
+
+    // trivially relocatable buffers live in ReallocStorage so they can grow in place
+    T* allocate(std::size_t count)
+    {
+        checkSize(count);
+        if (count)
+            m_Stats.allocated(count * sizeof(T));
+        if constexpr (UsesReallocStorage)
+            return static_cast<T*>(ReallocStorage::allocate(count * sizeof(T)));
+        else
+            return count ? AllocTraits::allocate(m_Allocator, count) : nullptr;
+    }
+
+    void deallocate(T* p, std::size_t count)
+    {
+        if constexpr (UsesReallocStorage)
+            ReallocStorage::deallocate(p, count * sizeof(T));
+        else if (p)
+            AllocTraits::deallocate(m_Allocator, p, count);
+    }
+
+    // move count elements from `from` down to `to` (to <= from); the elements
+    // overwritten must already be destroyed for trivially relocatable types,
+    // for other types they are assigned over and the caller ends the tail
+    void moveDown(std::size_t from, std::size_t to, std::size_t count)
+    {
+        if (from == to || count == 0)
+            return;
+        m_Stats.shifted(count);
+        if constexpr (is_trivially_relocatable_v<T>)
+            std::memmove(static_cast<void*>(m_Array + to), m_Array + from, count * sizeof(T));
+        else
+            for (std::size_t i = 0; i < count; i++)
+                m_Array[to + i] = std::move(m_Array[from + i]);
+    }
+
+    // take over array's buffer; this vector must hold no buffer and use a compatible allocator
+    void steal(MyVector& array)
+    {
+        m_Size = array.size();
+        m_Capacity = array.capacity();
+        m_Array = array.data();
+        array.m_Size = 0;
+        array.m_Capacity = 0;
+        array.m_Array = nullptr;
+    }
+
+    // end the elements past n
+    void truncate(std::size_t n)
+    {
+        std::destroy(m_Array + n, m_Array + size());
+        m_Size = n;
+    }
+
+    // set the capacity to exactly cap, dropping elements that no longer fit
+    void reallocate(std::size_t cap)
+    {
+        if (capacity() == cap)
+            return;
+
+        checkSize(cap);
+        m_Stats.resized();
+        if constexpr (UsesReallocStorage)
+        {
+            if (size() > cap)
+                truncate(cap);
+            if (cap)
+                m_Stats.allocated(cap * sizeof(T));
+            m_Array = static_cast<T*>(ReallocStorage::reallocate(m_Array, capacity() * sizeof(T), cap * sizeof(T), size() * sizeof(T)));
+        }
+        else
+        {
+            // nothing changes until the new buffer holds every element
+            T* newArray = allocate(cap);
+            try
+            {
+                move(data(), newArray, std::min(size(), cap));
+            }
+            catch (...)
+            {
+                deallocate(newArray, cap);
+                throw;
+            }
+            if (size() > cap)
+                truncate(cap);
+            deallocate(m_Array, capacity());
+            m_Array = newArray;
+        }
+        m_Capacity = cap;
+    }
+
+    // make room for at least `required` elements using the growth policy
+    void grow(std::size_t required)
+    {
+        reallocate(GrowthPolicy::grow(capacity(), required, sizeof(T)));
     }
 
 public:
-    MyVector(const std::size_t& capacity = 2)
-        : m_Capacity(capacity),
-        m_Array((T*)::operator new(capacity * sizeof(T)))
+    // a default constructed vector does not allocate until the first insertion
+    MyVector(const std::size_t& capacity = 0, const Allocator& alloc = Allocator())
+        : m_Allocator(alloc),
+        m_Capacity(capacity),
+        m_Array(allocate(capacity))
     {
     }
 
-    MyVector(std::initializer_list<T> l)
-        : m_Size(l.size()),
+    explicit MyVector(const Allocator& alloc)
+        : MyVector(0, alloc)
+    {
+    }
+
+    MyVector(std::initializer_list<T> l, const Allocator& alloc = Allocator())
+        : m_Allocator(alloc),
         m_Capacity(l.size()),
-        m_Array((T*)::operator new(l.size() * sizeof(T)))
+        m_Array(allocate(l.size()))
     {
-        copy(std::data(l), data(), l.size());
+        try
+        {
+            copy(std::data(l), data(), l.size());
+        }
+        catch (...)
+        {
+            deallocate(m_Array, capacity());
+            throw;
+        }
+        m_Size = l.size();
     }
 
-    MyVector(const MyVector<T>& array)
-        : m_Size(array.size()),
+    MyVector(const MyVector& array)
+        : m_Allocator(AllocTraits::select_on_container_copy_construction(array.get_allocator())),
         m_Capacity(array.capacity()),
-        m_Array((T*)::operator new(array.capacity() * sizeof(T)))
+        m_Array(allocate(array.capacity()))
     {
-        copy(array.data(), data(), std::min(array.size(), size()));
+        try
+        {
+            copy(array.data(), data(), array.size());
+        }
+        catch (...)
+        {
+            deallocate(m_Array, capacity());
+            throw;
+        }
+        m_Size = array.size();
     }
 
-    MyVector(MyVector<T>&& array)
-        : m_Capacity(std::move(array.capacity())),
-        m_Size(std::move(array.size())),
-        m_Array(std::move(array.data()))
+    // noexcept, so containers of vectors move them when they grow
+    MyVector(MyVector&& array) noexcept
+        : m_Allocator(std::move(array.m_Allocator)),
+        m_Size(array.size()),
+        m_Capacity(array.capacity()),
+        m_Array(array.data())
     {
+        array.m_Size = 0;
+        array.m_Capacity = 0;
         array.m_Array = nullptr;
     }
 
+    MyVector& operator=(const MyVector& array)
+    {
+        if (this == &array)
+            return *this;
+
+        if constexpr (!std::is_nothrow_copy_constructible_v<T>)
+        {
+            // copy into a buffer of our own first, a throw then leaves this vector as it was
+            constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+            MyVector copied(0, propagate ? array.m_Allocator : m_Allocator);
+            copied.reserve(array.size());
+            copied.append(array.data(), array.size());
+            hardClear();
+            if constexpr (propagate)
+                m_Allocator = array.m_Allocator;
+            steal(copied);
+            return *this;
+        }
+
+        softClear();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            if (m_Allocator != array.m_Allocator)
+                hardClear();
+            m_Allocator = array.m_Allocator;
+        }
+        reserve(array.size());
+        copy(array.data(), data(), array.size());
+        m_Size = array.size();
+        return *this;
+    }
+
+    // only an allocator that stays behind can make moving the elements throw
+    MyVector& operator=(MyVector&& array) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                                   AllocTraits::is_always_equal::value)
+    {
+        if (this == &array)
+            return *this;
+
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value)
+        {
+            // the buffer belongs to another allocator, move the elements instead
+            if (m_Allocator != array.m_Allocator)
+            {
+                softClear();
+                reserve(array.size());
+                std::uninitialized_move_n(array.data(), array.size(), data());
+                m_Size = array.size();
+                array.softClear();
+                return *this;
+            }
+        }
+        hardClear();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            m_Allocator = std::move(array.m_Allocator);
+        steal(array);
+        return *this;
+    }
+
     ~MyVector()
     {
-        delete[] m_Array;
+        std::destroy_n(m_Array, size());
+        deallocate(m_Array, capacity());
     }
 
     T& operator[](const std::size_t& index)
@@ -155,34 +623,79 @@ public:
         return data()[index];
     }
 
-    void resize(const std::size_t& cap)
+    // make room for n elements without changing the size; never shrinks, so
+    // pointers into the buffer stay valid when it is already large enough
+    void reserve(const std::size_t& n)
     {
-        if (capacity() == cap)
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    // set the size to n, new elements are value-initialized (zero for
+    // arithmetic types); growing gives the strong guarantee
+    void resize(const std::size_t& n)
+    {
+        if (n <= size())
+        {
+            truncate(n);
             return;
-        
-        m_Capacity = cap;
-        if (size() > cap)
-            m_Size = cap;
-        T* newArray = (T*)::operator new(cap * sizeof(T));
-        move(data(), newArray, size());
-        delete[] m_Array;
-        m_Array = newArray;
+        }
+        std::size_t count = n - size();
+        insertGap<std::is_nothrow_default_constructible_v<T>>(size(), count, [&](T* gap) {
+            std::uninitialized_value_construct_n(gap, count);
+        });
+    }
+
+    // set the size to n, new elements are copies of value
+    void resize(const std::size_t& n, const T& value)
+    {
+        if (n <= size())
+        {
+            truncate(n);
+            return;
+        }
+        std::size_t count = n - size();
+        if constexpr (std::is_nothrow_copy_constructible_v<T>)
+        {
+            // value may be an element of this vector, which growing in place moves
+            const T item(value);
+            insertGap<true>(size(), count, [&](T* gap) { std::uninitialized_fill_n(gap, count, item); });
+        }
+        else
+        {
+            // the old buffer outlives the copies, so value stays valid
+            insertGap<false>(size(), count, [&](T* gap) { std::uninitialized_fill_n(gap, count, value); });
+        }
+    }
+
+    // Set the size to n without initializing the new elements, for buffers
+    // filled right after through data(), e.g. by read() or a decoder. Only
+    // for trivially copyable types, whose objects exist once their bytes are
+    // written.
+    void resize_uninitialized(const std::size_t& n)
+        requires std::is_trivially_copyable_v<T>
+    {
+        if (n > capacity())
+            grow(n);
+        m_Size = n;
     }
 
     // shrink capacity to size
     void shrinkToFit()
     {
-        resize(size());
+        reallocate(size());
     }
 
+    // destroy every element and keep the buffer
     void softClear()
     {
-        m_Size = 0;
+        truncate(0);
     }
 
+    // destroy every element and free the buffer
     void hardClear()
     {
-        resize(0);
+        reallocate(0);
     }
     
     void clear()
@@ -196,68 +709,255 @@ public:
         if (index >= size())
             throw std::out_of_range("Index out of bound");
 
-        // shifting left
-        for (std::size_t i = index, end = size() - 1; i < end; ++i)
-            at(i) = at(i + 1);
+        shiftLeft(index);
         --m_Size;
     }
 
-    void insert(const std::size_t& index, const T& item)
+    // remove element at index in O(1) by moving the last element into its place,
+    // the order of the remaining elements is not kept
+    void swap_remove(const std::size_t& index)
     {
-        if (index > size())
+        if (index >= size())
             throw std::out_of_range("Index out of bound");
 
-        if (size() == capacity())
-            resize(capacity() * 1.5);
+        if (index != size() - 1)
+        {
+            m_Array[index] = std::move(m_Array[size() - 1]);
+            m_Stats.shifted(1);
+        }
+        pop_back();
+    }
 
-        // shifting right
-        for (std::size_t i = size(); i > index; --i)
-            m_Array[i] = at(i - 1);
-        at(index) = item;
-        ++m_Size;
+    // remove every element matching pred, filling holes from the back;
+    // returns how many were removed
+    template<typename Predicate>
+    std::size_t swap_remove_if(Predicate pred)
+    {
+        std::size_t before = size();
+        for (std::size_t i = 0; i < size();)
+        {
+            if (pred(m_Array[i]))
+                swap_remove(i);
+            else
+                ++i;
+        }
+        return before - size();
     }
-    
+
+    // remove [first, last) and shift the tail down once
+    void remove_range(const std::size_t& first, const std::size_t& last)
+    {
+        if (first > last || last > size())
+            throw std::out_of_range("Index out of bound");
+
+        if constexpr (is_trivially_relocatable_v<T>)
+            std::destroy(m_Array + first, m_Array + last);
+        moveDown(last, first, size() - last);
+        if constexpr (!is_trivially_relocatable_v<T>)
+            std::destroy(m_Array + size() - (last - first), m_Array + size());
+        m_Size -= last - first;
+    }
+
+    // remove the elements at the given strictly ascending indices in one pass
+    void remove_indices(const std::size_t* indices, std::size_t count)
+    {
+        if (count == 0)
+            return;
+        for (std::size_t k = 0; k < count; k++)
+        {
+            if (indices[k] >= size())
+                throw std::out_of_range("Index out of bound");
+            if (k && indices[k] <= indices[k - 1])
+                throw std::invalid_argument("Indices must be sorted and unique");
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>)
+            for (std::size_t k = 0; k < count; k++)
+                std::destroy_at(m_Array + indices[k]);
+
+        // move each run of survivors between two removed indices down once
+        std::size_t write = indices[0];
+        for (std::size_t k = 0; k < count; k++)
+        {
+            std::size_t run = indices[k] + 1;
+            std::size_t next = k + 1 < count ? indices[k + 1] : size();
+            moveDown(run, write, next - run);
+            write += next - run;
+        }
+        if constexpr (!is_trivially_relocatable_v<T>)
+            std::destroy(m_Array + write, m_Array + size());
+        m_Size = write;
+    }
+
+    void remove_indices(std::span<const std::size_t> indices)
+    {
+        remove_indices(indices.data(), indices.size());
+    }
+
+    // remove every element matching pred, returns how many were removed
+    template<typename Predicate>
+    std::size_t erase_if(Predicate pred)
+    {
+        std::size_t write = 0;
+        for (std::size_t read = 0; read < size(); ++read)
+        {
+            if (pred(m_Array[read]))
+                continue;
+            if (write != read)
+            {
+                m_Array[write] = std::move(m_Array[read]);
+                m_Stats.shifted(1);
+            }
+            ++write;
+        }
+        std::size_t removed = size() - write;
+        std::destroy(m_Array + write, m_Array + size());
+        m_Size = write;
+        return removed;
+    }
+
+    // item may be an element of this vector, so it is copied before shifting
+    void insert(const std::size_t& index, const T& item)
+    {
+        insert(index, T(item));
+    }
+
     void insert(const std::size_t& index, T&& item)
     {
         if (index > size())
             throw std::out_of_range("Index out of bound");
 
-        if (size() == capacity())
-            resize(capacity() * 1.5);
+        insertGap<std::is_nothrow_move_constructible_v<T>>(index, 1, [&](T* gap) {
+            new(gap) T(std::move_if_noexcept(item));
+        });
+    }
+
+    // insert [first, last) before index, reallocating at most once;
+    // the range must not point into this vector
+    template<std::input_iterator InputIt>
+    void insert(const std::size_t& index, InputIt first, InputIt last)
+    {
+        if (index > size())
+            throw std::out_of_range("Index out of bound");
+
+        if constexpr (IsForwardIterator<InputIt>)
+        {
+            std::size_t count = std::distance(first, last);
+            if (count == 0)
+                return;
+
+            insertGap<std::is_nothrow_constructible_v<T, std::iter_reference_t<InputIt>>>(index, count, [&](T* gap) {
+                copyRange(first, count, gap);
+            });
+        }
+        else
+        {
+            // single pass iterators can't be measured up front, buffer them first
+            MyVector buffer;
+            buffer.append(first, last);
+            insert(index, buffer.data(), buffer.data() + buffer.size());
+        }
+    }
+
+    // append [first, last), reallocating at most once for forward iterators;
+    // a contiguous range may point into this vector, any other must not
+    template<std::input_iterator InputIt>
+    void append(InputIt first, InputIt last)
+    {
+        if constexpr (std::contiguous_iterator<InputIt> && std::is_same_v<std::iter_value_t<InputIt>, T>)
+        {
+            append(std::to_address(first), std::size_t(last - first));
+        }
+        else if constexpr (IsForwardIterator<InputIt>)
+        {
+            std::size_t count = std::distance(first, last);
+            insertGap<std::is_nothrow_constructible_v<T, std::iter_reference_t<InputIt>>>(size(), count, [&](T* gap) {
+                copyRange(first, count, gap);
+            });
+        }
+        else
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+    }
+
+    // append count elements from items, which may point into this vector
+    void append(const T* items, std::size_t count)
+    {
+        if constexpr (!std::is_nothrow_copy_constructible_v<T>)
+        {
+            // the old buffer outlives the copies, so items may still point into it
+            insertGap<false>(size(), count, [&](T* gap) { copyRange(items, count, gap); });
+            return;
+        }
+
+        if (size() + count > capacity())
+        {
+            if (items >= data() && items < data() + size())
+            {
+                std::size_t offset = items - data();
+                grow(size() + count);
+                items = data() + offset;
+            }
+            else
+            {
+                grow(size() + count);
+            }
+        }
+        copyRange(items, count, m_Array + size());
+        m_Size += count;
+    }
 
-        // shifting right
-        for (std::size_t i = size(); i > index; --i)
-            m_Array[i] = at(i - 1);
-        at(index) = std::move(item);
-        ++m_Size;
+    // replace the contents with [first, last); the range must not point into this vector
+    template<std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+        softClear();
+        if constexpr (IsForwardIterator<InputIt>)
+        {
+            reserve(std::distance(first, last));
+        }
+        append(first, last);
     }
 
     void pop_back()
     {
-        --m_Size;
+        std::destroy_at(m_Array + --m_Size);
     }
 
     void push_back(const T& item)
     {
-        if (size() >= capacity())
-            resize(capacity() * 1.5);
-        at(m_Size++) = item;
+        emplace_back(item);
     }
-    
+
     void push_back(T&& item)
     {
-        if (size() >= capacity())
-            resize(capacity() * 1.5);
-        at(m_Size++) = std::move(item);
+        emplace_back(std::move(item));
     }
 
+    // args may refer to an element of this vector: when the buffer has to
+    // grow, the new element is built before the old buffer goes away
     template<typename... Args>
     void emplace_back(Args&&... args)
     {
-        if (size() >= capacity())
-            resize(capacity() * 1.5);
-        new(&m_Array[size()]) T(std::forward<Args>(args)...);
-        ++m_Size;
+        if (size() < capacity())
+        {
+            new(m_Array + size()) T(std::forward<Args>(args)...);
+            ++m_Size;
+        }
+        else if constexpr (UsesReallocStorage && std::is_nothrow_move_constructible_v<T>)
+        {
+            // realloc frees the old buffer itself, so build the element aside first
+            T item(std::forward<Args>(args)...);
+            grow(size() + 1);
+            new(m_Array + size()) T(std::move(item));
+            ++m_Size;
+        }
+        else
+        {
+            rebuildWithGap(size(), 1, [&](T* gap) { new(gap) T(std::forward<Args>(args)...); });
+        }
     }
     
     // pointer to the array that is storing the data
@@ -281,24 +981,35 @@ public:
         return Iterator(data() + size());
     }
 
-    const Iterator begin() const 
+    ConstIterator begin() const 
     {
-        return Iterator(data());
+        return ConstIterator(data());
     }
 
-    const Iterator end() const
+    ConstIterator end() const
     {
-        return Iterator(data() + size());
+        return ConstIterator(data() + size());
     }
     
-    const Iterator cbegin() const 
+    ConstIterator cbegin() const 
     {
-        return Iterator(data());
+        return ConstIterator(data());
     }
 
-    const Iterator cend() const
+    ConstIterator cend() const
     {
-        return Iterator(data() + size());
+        return ConstIterator(data() + size());
+    }
+
+    // this vector's counters, all zero unless built with MYVECTOR_STATS
+    MyVectorStats stats() const
+    {
+        return m_Stats.get();
+    }
+
+    Allocator get_allocator() const
+    {
+        return m_Allocator;
     }
 
     T& front()
@@ -325,4 +1036,14 @@ public:
     {
         return m_Capacity;
     }
+
+    // the most elements a buffer can hold without its byte size overflowing
+    std::size_t max_size() const
+    {
+        return std::min<std::size_t>(AllocTraits::max_size(m_Allocator), std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T));
+    }
 };
+
+// vector whose buffers come from a std::pmr::memory_resource, e.g. an arena
+template<typename T, typename GrowthPolicy = GeometricGrowth<>>
+using MyPmrVector = MyVector<T, GrowthPolicy, std::pmr::polymorphic_allocator<T>>;
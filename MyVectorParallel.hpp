@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "MyVector.hpp"
+
+// Parallel for_each, transform, reduce and sort over MyVector contents.
+//
+// Work runs on a ThreadPool whose workers each own a task deque: a worker
+// pops its own newest task and, when it runs dry, steals the oldest task of
+// another worker. The thread that starts an algorithm helps run tasks until
+// its own are done, so algorithms can be nested inside each other.
+//
+// A vector is cut into ranges of `grain` elements rounded up to a whole
+// number of cache lines. parallel_for and parallel_transform shorten the
+// first range so the others start on a line of the buffer they write, and
+// threads writing neighbouring ranges never share a line. parallel_reduce
+// and parallel_sort cut from index 0 wherever the buffer sits.
+namespace myvec::parallel
+{
+
+inline constexpr std::size_t CacheLine = 64;
+inline constexpr std::size_t DefaultGrain = 16384;
+
+class ThreadPool
+{
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+    std::vector<std::thread> m_Threads;
+    std::mutex m_SleepMutex;
+    std::condition_variable m_Wake;
+    std::atomic<std::size_t> m_Queued{0};
+    std::atomic<std::size_t> m_NextQueue{0};
+    bool m_Stop = false;
+
+    // which pool and queue the current thread works for
+    static inline thread_local ThreadPool* t_Pool = nullptr;
+    static inline thread_local std::size_t t_Queue = 0;
+
+    void push(std::function<void()> task)
+    {
+        std::size_t index = t_Pool == this ? t_Queue : m_NextQueue++ % m_Queues.size();
+        {
+            std::lock_guard<std::mutex> lock(m_Queues[index]->mutex);
+            m_Queues[index]->tasks.push_back(std::move(task));
+        }
+        m_Queued++;
+        // taking the lock orders the notify after a sleeper's check of m_Queued
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Wake.notify_one();
+    }
+
+    // run one task: our own newest first, otherwise steal another queue's oldest
+    bool tryRunOne()
+    {
+        std::function<void()> task;
+        std::size_t own = t_Pool == this ? t_Queue : 0;
+        for (std::size_t i = 0; i < m_Queues.size() && !task; i++)
+        {
+            Queue& queue = *m_Queues[(own + i) % m_Queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0 && t_Pool == this)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        if (!task)
+            return false;
+
+        m_Queued--;
+        task();
+        return true;
+    }
+
+    void work(std::size_t index)
+    {
+        t_Pool = this;
+        t_Queue = index;
+        while (true)
+        {
+            if (tryRunOne())
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_Wake.wait(lock, [this] { return m_Stop || m_Queued > 0; });
+            if (m_Stop && m_Queued == 0)
+                return;
+        }
+    }
+
+public:
+    // `threads` counts the caller, a pool of 1 runs everything inline
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+    {
+        std::size_t workers = std::max<std::size_t>(threads, 1) - 1;
+        for (std::size_t i = 0; i < workers; i++)
+            m_Queues.push_back(std::make_unique<Queue>());
+        for (std::size_t i = 0; i < workers; i++)
+            m_Threads.emplace_back([this, i] { work(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // finishes the queued tasks, then joins the workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_all();
+        for (std::thread& thread : m_Threads)
+            thread.join();
+    }
+
+    // pool shared by the algorithms when none is passed
+    static ThreadPool& global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    std::size_t size() const
+    {
+        return m_Threads.size() + 1;
+    }
+
+    // call fn(i) for every i in [0, count) and wait for all of them; the
+    // first exception thrown by fn is rethrown here once every call is done
+    template<typename Fn>
+    void run(std::size_t count, Fn&& fn)
+    {
+        if (m_Threads.empty() || count == 1)
+        {
+            for (std::size_t i = 0; i < count; i++)
+                fn(i);
+            return;
+        }
+
+        std::atomic<std::size_t> remaining(count);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            push([&, i] {
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!tryRunOne())
+                std::this_thread::yield();
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+namespace detail
+{
+
+// fewest elements that fill a whole number of cache lines
+template<typename T>
+constexpr std::size_t lineElements()
+{
+    return CacheLine / std::gcd(CacheLine, sizeof(T));
+}
+
+// grain rounded up to a whole number of cache lines
+template<typename T>
+std::size_t chunkSize(std::size_t grain)
+{
+    std::size_t line = lineElements<T>();
+    return std::max<std::size_t>((grain + line - 1) / line, 1) * line;
+}
+
+// how many elements to take off the first range of `chunk` elements so the
+// next ones start on a cache line of data, 0 if no element starts on one
+template<typename T>
+std::size_t lineSkew(const T* data, std::size_t chunk)
+{
+    std::size_t offset = reinterpret_cast<std::uintptr_t>(data) % CacheLine;
+    for (std::size_t lead = 0; lead < lineElements<T>(); lead++)
+    {
+        if ((offset + lead * sizeof(T)) % CacheLine == 0)
+            return lead == 0 ? 0 : chunk - lead;
+    }
+    return 0;
+}
+
+// fn(begin, end) over consecutive ranges of `chunk` elements, the first one
+// `skew` elements shorter
+template<typename Fn>
+void forEachRange(std::size_t n, std::size_t chunk, std::size_t skew, ThreadPool& pool, Fn&& fn)
+{
+    pool.run(n == 0 ? 0 : (n + skew + chunk - 1) / chunk, [&](std::size_t i) {
+        fn(std::max(i * chunk, skew) - skew, std::min(n, (i + 1) * chunk - skew));
+    });
+}
+
+} // namespace detail
+
+// fn(element) for every element
+template<typename T, typename... Rest, typename Fn>
+void parallel_for(MyVector<T, Rest...>& v, Fn fn, ThreadPool& pool = ThreadPool::global(),
+                  std::size_t grain = DefaultGrain)
+{
+    T* data = v.data();
+    std::size_t chunk = detail::chunkSize<T>(grain);
+    detail::forEachRange(v.size(), chunk, detail::lineSkew(data, chunk), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            fn(data[i]);
+    });
+}
+
+// out[i] = fn(in[i]); out must already hold as many elements as in, and may be in itself
+template<typename T, typename... Rest, typename U, typename... OutRest, typename Fn>
+void parallel_transform(const MyVector<T, Rest...>& in, MyVector<U, OutRest...>& out, Fn fn,
+                        ThreadPool& pool = ThreadPool::global(), std::size_t grain = DefaultGrain)
+{
+    if (out.size() < in.size())
+        throw std::invalid_argument("output is shorter than input");
+
+    const T* from = in.data();
+    U* to = out.data();
+    std::size_t chunk = detail::chunkSize<U>(grain);
+    detail::forEachRange(in.size(), chunk, detail::lineSkew(to, chunk), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            to[i] = fn(from[i]);
+    });
+}
+
+// Fold with an associative op. The ranges depend only on the size and the
+// grain and their results are combined left to right, so the result is the
+// same bit for bit whatever the number of threads or the scheduling.
+template<typename T, typename... Rest, typename Op = std::plus<>>
+T parallel_reduce(const MyVector<T, Rest...>& v, T init, Op op = Op(), ThreadPool& pool = ThreadPool::global(),
+                  std::size_t grain = DefaultGrain)
+{
+    const T* data = v.data();
+    std::size_t chunk = detail::chunkSize<T>(grain);
+    std::vector<T> partials((v.size() + chunk - 1) / chunk, init);
+    detail::forEachRange(v.size(), chunk, 0, pool, [&](std::size_t begin, std::size_t end) {
+        T sum = data[begin];
+        for (std::size_t i = begin + 1; i < end; i++)
+            sum = op(sum, data[i]);
+        partials[begin / chunk] = sum;
+    });
+
+    for (const T& partial : partials)
+        init = op(init, partial);
+    return init;
+}
+
+// sort one range per thread, then merge neighbouring ranges in rounds
+template<typename T, typename... Rest, typename Compare = std::less<>>
+void parallel_sort(MyVector<T, Rest...>& v, Compare comp = Compare(), ThreadPool& pool = ThreadPool::global(),
+                   std::size_t grain = DefaultGrain)
+{
+    const std::size_t n = v.size();
+    T* data = v.data();
+    std::size_t chunk = detail::chunkSize<T>(std::max(grain, (n + pool.size() - 1) / pool.size()));
+    detail::forEachRange(n, chunk, 0, pool, [&](std::size_t begin, std::size_t end) {
+        std::sort(data + begin, data + end, comp);
+    });
+
+    for (std::size_t width = chunk; width < n; width *= 2)
+    {
+        pool.run((n + 2 * width - 1) / (2 * width), [&](std::size_t i) {
+            std::size_t begin = i * 2 * width;
+            std::size_t middle = std::min(n, begin + width);
+            std::size_t end = std::min(n, begin + 2 * width);
+            std::inplace_merge(data + begin, data + middle, data + end, comp);
+        });
+    }
+}
+
+} // namespace myvec::parallel
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "MyVector.hpp"
+
+// Binary format for vectors of trivially copyable elements: a 64-byte header
+// followed by the raw elements, so saving is one writev and loading is one
+// read straight into the vector, or a view over a mapping with no copy at all.
+//
+// Values are stored in the native byte order; a file written on a machine of
+// the other endianness fails the version check.
+namespace myvec
+{
+
+struct SerialHeader
+{
+    static constexpr char Magic[8] = {'M', 'Y', 'V', 'E', 'C', 'T', 'O', 'R'};
+    static constexpr std::uint32_t CurrentVersion = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;  // offset of the first element
+    std::uint32_t elementSize;
+    std::uint32_t alignment;
+    std::uint64_t count;
+    std::uint64_t checksum;    // of the element bytes, see checksum()
+    std::uint8_t reserved[24]; // zero, ignored when reading
+};
+
+static_assert(sizeof(SerialHeader) == 64, "the header is part of the file format");
+
+// the file is well formed but doesn't match what the reader expects
+struct SerializationError : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// 64-bit hash of a byte range, four independent lanes so it runs at memory speed
+inline std::uint64_t checksum(const void* data, std::size_t bytes)
+{
+    constexpr std::uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    auto round = [](std::uint64_t h, std::uint64_t word) {
+        h += word * P2;
+        h = (h << 31) | (h >> 33);
+        return h * P1;
+    };
+
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t lane[4] = {P1, P2, ~P1, ~P2};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p + i + 8 * k, 8);
+            lane[k] = round(lane[k], word);
+        }
+    }
+
+    std::uint64_t h = bytes;
+    for (std::uint64_t l : lane)
+        h = round(h, l);
+    for (; i < bytes; i++)
+        h = round(h, p[i]);
+    return h ^ (h >> 29);
+}
+
+namespace detail
+{
+
+[[noreturn]] inline void fail(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// writev until everything is out, the kernel may take less per call
+inline void writeAll(int fd, iovec* parts, int count)
+{
+    while (count > 0)
+    {
+        ssize_t written = writev(fd, parts, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fail("writev");
+        }
+        // skip the parts that went out whole, then trim the one cut short
+        std::size_t left = written;
+        while (count > 0 && left >= parts->iov_len)
+        {
+            left -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+        if (count > 0)
+        {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + left;
+            parts->iov_len -= left;
+        }
+    }
+}
+
+inline void readAll(int fd, void* to, std::size_t bytes)
+{
+    char* p = static_cast<char*>(to);
+    while (bytes > 0)
+    {
+        ssize_t got = read(fd, p, bytes);
+        if (got < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fail("read");
+        }
+        if (got == 0)
+            throw SerializationError("file is truncated");
+        p += got;
+        bytes -= got;
+    }
+}
+
+template<typename T>
+void checkHeader(const SerialHeader& header)
+{
+    if (std::memcmp(header.magic, SerialHeader::Magic, sizeof(header.magic)) != 0)
+        throw SerializationError("not a serialized MyVector");
+    if (header.version != SerialHeader::CurrentVersion || header.headerSize != sizeof(SerialHeader))
+        throw SerializationError("unsupported format version");
+    if (header.elementSize != sizeof(T) || header.alignment != alignof(T))
+        throw SerializationError("element type does not match");
+}
+
+} // namespace detail
+
+// write the header and the elements to fd with one writev
+template<typename T, typename... Rest>
+void serialize(const MyVector<T, Rest...>& v, int fd)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    SerialHeader header = {};
+    std::memcpy(header.magic, SerialHeader::Magic, sizeof(header.magic));
+    header.version = SerialHeader::CurrentVersion;
+    header.headerSize = sizeof(SerialHeader);
+    header.elementSize = sizeof(T);
+    header.alignment = alignof(T);
+    header.count = v.size();
+    header.checksum = checksum(v.data(), v.size() * sizeof(T));
+
+    iovec parts[2] = {
+        {&header, sizeof(header)},
+        {const_cast<T*>(v.data()), v.size() * sizeof(T)}
+    };
+    detail::writeAll(fd, parts, v.size() ? 2 : 1);
+}
+
+// read a vector written by serialize, the elements land in the vector with one read
+template<typename T>
+MyVector<T> deserialize(int fd)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    SerialHeader header;
+    detail::readAll(fd, &header, sizeof(header));
+    detail::checkHeader<T>(header);
+
+    if (header.count > SIZE_MAX / sizeof(T))
+        throw SerializationError("element count is too large");
+
+    MyVector<T> v;
+    struct stat info;
+    off_t position = lseek(fd, 0, SEEK_CUR);
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && position >= 0)
+    {
+        // check a regular file really holds count elements before allocating them
+        if (header.count > std::uint64_t(info.st_size - position) / sizeof(T))
+            throw SerializationError("file is truncated");
+        v.resize_uninitialized(header.count);
+        detail::readAll(fd, v.data(), v.size() * sizeof(T));
+    }
+    else
+    {
+        // a pipe or socket can't be measured, so grow with the data that
+        // actually arrives instead of trusting the header's count
+        const std::size_t chunk = std::max<std::size_t>((std::size_t(1) << 20) / sizeof(T), 1);
+        while (v.size() < header.count)
+        {
+            std::size_t from = v.size();
+            std::size_t count = std::min<std::size_t>(header.count - from, chunk);
+            v.resize_uninitialized(from + count);
+            detail::readAll(fd, v.data() + from, count * sizeof(T));
+        }
+    }
+    if (checksum(v.data(), v.size() * sizeof(T)) != header.checksum)
+        throw SerializationError("checksum mismatch");
+    return v;
+}
+
+// Adopt the elements of a serialized buffer, e.g. a read-only mapping of the
+// file, without copying. The span points into buffer, which must outlive it
+// and be aligned for T (mappings are). verify=false skips the checksum scan.
+template<typename T>
+std::span<const T> view(const void* buffer, std::size_t bytes, bool verify = true)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized");
+
+    if (bytes < sizeof(SerialHeader))
+        throw SerializationError("file is truncated");
+    SerialHeader header;
+    std::memcpy(&header, buffer, sizeof(header));
+    detail::checkHeader<T>(header);
+    if (header.count > (bytes - sizeof(SerialHeader)) / sizeof(T))
+        throw SerializationError("file is truncated");
+
+    const T* elements = reinterpret_cast<const T*>(static_cast<const char*>(buffer) + sizeof(SerialHeader));
+    if (verify && checksum(elements, header.count * sizeof(T)) != header.checksum)
+        throw SerializationError("checksum mismatch");
+    return std::span<const T>(elements, header.count);
+}
+
+// Maps a serialized file read-only and views its elements in place. The
+// elements stay valid for as long as this object lives.
+template<typename T>
+class MappedView
+{
+private:
+    void* m_Mapping = nullptr;
+    std::size_t m_Bytes = 0;
+    std::span<const T> m_Elements;
+
+public:
+    explicit MappedView(int fd, bool verify = true)
+    {
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+            detail::fail("fstat");
+        m_Bytes = info.st_size;
+        if (m_Bytes == 0)
+            throw SerializationError("file is truncated");
+
+        m_Mapping = mmap(nullptr, m_Bytes, PROT_READ, MAP_SHARED, fd, 0);
+        if (m_Mapping == MAP_FAILED)
+            detail::fail("mmap");
+        try
+        {
+            m_Elements = view<T>(m_Mapping, m_Bytes, verify);
+        }
+        catch (...)
+        {
+            munmap(m_Mapping, m_Bytes);
+            throw;
+        }
+    }
+
+    MappedView(const MappedView&) = delete;
+    MappedView& operator=(const MappedView&) = delete;
+
+    ~MappedView()
+    {
+        munmap(m_Mapping, m_Bytes);
+    }
+
+    const T& operator[](const std::size_t& index) const
+    {
+        return m_Elements[index];
+    }
+
+    const T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return m_Elements[index];
+    }
+
+    std::span<const T> span() const
+    {
+        return m_Elements;
+    }
+
+    const T* data() const
+    {
+        return m_Elements.data();
+    }
+
+    auto begin() const
+    {
+        return m_Elements.begin();
+    }
+
+    auto end() const
+    {
+        return m_Elements.end();
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Elements.size();
+    }
+};
+
+} // namespace myvec
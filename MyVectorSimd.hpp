@@ -0,0 +1,623 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "MyVector.hpp"
+
+// the kernels use 64-bit lane extracts, so 32-bit x86 gets the scalar versions
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define MYVEC_SIMD_X86 1
+#endif
+
+// Vectorized reductions and searches over int, float and double buffers.
+// Every kernel has a scalar, an SSE4.1 and an AVX2 version; the widest one
+// the CPU supports is picked at runtime, setLevel() can force a lower one.
+//
+// sum and dot of ints accumulate in 64 bits. Floating point sums are
+// reassociated across lanes, so they can differ from a scalar loop in the
+// last bits. NaNs give unspecified results for minmax.
+namespace myvec::simd
+{
+
+enum class Level
+{
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+inline Level detectLevel()
+{
+#ifdef MYVEC_SIMD_X86
+    // count_eq also needs popcnt, which every CPU with sse4.2 or later has
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("popcnt"))
+        return Level::Scalar;
+    if (__builtin_cpu_supports("avx2"))
+        return Level::AVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return Level::SSE41;
+#endif
+    return Level::Scalar;
+}
+
+namespace detail
+{
+
+// atomic, so setLevel() may run while pool threads are inside a kernel
+inline std::atomic<Level>& currentLevel()
+{
+    static std::atomic<Level> level{detectLevel()};
+    return level;
+}
+
+template<typename T>
+using SumType = std::conditional_t<std::is_integral_v<T>, long long, T>;
+
+// ---- scalar ----
+
+template<typename T>
+SumType<T> sumScalar(const T* data, std::size_t n)
+{
+    SumType<T> sum = 0;
+    for (std::size_t i = 0; i < n; i++)
+        sum += data[i];
+    return sum;
+}
+
+template<typename T>
+std::pair<T, T> minmaxScalar(const T* data, std::size_t n, std::pair<T, T> result)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (data[i] < result.first)
+            result.first = data[i];
+        if (data[i] > result.second)
+            result.second = data[i];
+    }
+    return result;
+}
+
+template<typename T>
+std::size_t countScalar(const T* data, std::size_t n, T value)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++)
+        count += data[i] == value;
+    return count;
+}
+
+template<typename T>
+std::size_t findScalar(const T* data, std::size_t n, T value)
+{
+    for (std::size_t i = 0; i < n; i++)
+        if (data[i] == value)
+            return i;
+    return n;
+}
+
+template<typename T>
+SumType<T> dotScalar(const T* a, const T* b, std::size_t n)
+{
+    SumType<T> sum = 0;
+    for (std::size_t i = 0; i < n; i++)
+        sum += SumType<T>(a[i]) * b[i];
+    return sum;
+}
+
+#ifdef MYVEC_SIMD_X86
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2"))) inline long long hsum(__m256i v)
+{
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+
+__attribute__((target("avx2"))) inline float hsum(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+__attribute__((target("avx2"))) inline double hsum(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+__attribute__((target("avx2"))) inline long long sumAvx2(const int* data, std::size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline float sumAvx2(const float* data, std::size_t n)
+{
+    __m256 acc = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double sumAvx2(const double* data, std::size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(data + i));
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline std::pair<int, int> minmaxAvx2(const int* data, std::size_t n)
+{
+    __m256i lo = _mm256_set1_epi32(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        lo = _mm256_min_epi32(lo, v);
+        hi = _mm256_max_epi32(hi, v);
+    }
+    alignas(32) int los[8], his[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(los), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(his), hi);
+    std::pair<int, int> result = minmaxScalar(los, 8, {data[0], data[0]});
+    result = minmaxScalar(his, 8, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+__attribute__((target("avx2"))) inline std::pair<float, float> minmaxAvx2(const float* data, std::size_t n)
+{
+    __m256 lo = _mm256_set1_ps(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(data + i);
+        lo = _mm256_min_ps(lo, v);
+        hi = _mm256_max_ps(hi, v);
+    }
+    alignas(32) float los[8], his[8];
+    _mm256_store_ps(los, lo);
+    _mm256_store_ps(his, hi);
+    std::pair<float, float> result = minmaxScalar(los, 8, {data[0], data[0]});
+    result = minmaxScalar(his, 8, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+__attribute__((target("avx2"))) inline std::pair<double, double> minmaxAvx2(const double* data, std::size_t n)
+{
+    __m256d lo = _mm256_set1_pd(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = _mm256_loadu_pd(data + i);
+        lo = _mm256_min_pd(lo, v);
+        hi = _mm256_max_pd(hi, v);
+    }
+    alignas(32) double los[4], his[4];
+    _mm256_store_pd(los, lo);
+    _mm256_store_pd(his, hi);
+    std::pair<double, double> result = minmaxScalar(los, 4, {data[0], data[0]});
+    result = minmaxScalar(his, 4, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+// lane mask of the elements equal to value, one bit per element
+__attribute__((target("avx2"))) inline int eqMask(const int* p, __m256i value)
+{
+    __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), value);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+__attribute__((target("avx2"))) inline int eqMask(const float* p, __m256 value)
+{
+    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), value, _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2"))) inline int eqMask(const double* p, __m256d value)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), value, _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2"))) inline __m256i splat256(int value)
+{
+    return _mm256_set1_epi32(value);
+}
+
+__attribute__((target("avx2"))) inline __m256 splat256(float value)
+{
+    return _mm256_set1_ps(value);
+}
+
+__attribute__((target("avx2"))) inline __m256d splat256(double value)
+{
+    return _mm256_set1_pd(value);
+}
+
+template<typename T>
+__attribute__((target("avx2,popcnt"))) std::size_t countAvx2(const T* data, std::size_t n, T value)
+{
+    constexpr std::size_t lanes = 32 / sizeof(T);
+    auto v = splat256(value);
+    std::size_t count = 0, i = 0;
+    for (; i + lanes <= n; i += lanes)
+        count += __builtin_popcount(eqMask(data + i, v));
+    return count + countScalar(data + i, n - i, value);
+}
+
+template<typename T>
+__attribute__((target("avx2"))) std::size_t findAvx2(const T* data, std::size_t n, T value)
+{
+    constexpr std::size_t lanes = 32 / sizeof(T);
+    auto v = splat256(value);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+        if (int mask = eqMask(data + i, v))
+            return i + __builtin_ctz(mask);
+    return i + findScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline long long dotAvx2(const int* a, const int* b, std::size_t n)
+{
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // widen to 64 bits, _mm256_mul_epi32 multiplies the low signed halves
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(va)),
+                                                     _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vb))));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(va, 1)),
+                                                     _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vb, 1))));
+    }
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline float dotAvx2(const float* a, const float* b, std::size_t n)
+{
+    __m256 acc = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double dotAvx2(const double* a, const double* b, std::size_t n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+// ---- SSE4.1 ----
+
+__attribute__((target("sse4.1"))) inline long long hsum(__m128i v)
+{
+    return _mm_cvtsi128_si64(v) + _mm_extract_epi64(v, 1);
+}
+
+__attribute__((target("sse4.1"))) inline float hsum(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+__attribute__((target("sse4.1"))) inline double hsum(__m128d v)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+__attribute__((target("sse4.1"))) inline long long sumSse41(const int* data, std::size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(v));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_unpackhi_epi64(v, v)));
+    }
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline float sumSse41(const float* data, std::size_t n)
+{
+    __m128 acc = _mm_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline double sumSse41(const double* data, std::size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        acc = _mm_add_pd(acc, _mm_loadu_pd(data + i));
+    return hsum(acc) + sumScalar(data + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline std::pair<int, int> minmaxSse41(const int* data, std::size_t n)
+{
+    __m128i lo = _mm_set1_epi32(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        lo = _mm_min_epi32(lo, v);
+        hi = _mm_max_epi32(hi, v);
+    }
+    alignas(16) int los[4], his[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(los), lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(his), hi);
+    std::pair<int, int> result = minmaxScalar(los, 4, {data[0], data[0]});
+    result = minmaxScalar(his, 4, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+__attribute__((target("sse4.1"))) inline std::pair<float, float> minmaxSse41(const float* data, std::size_t n)
+{
+    __m128 lo = _mm_set1_ps(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(data + i);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+    }
+    alignas(16) float los[4], his[4];
+    _mm_store_ps(los, lo);
+    _mm_store_ps(his, hi);
+    std::pair<float, float> result = minmaxScalar(los, 4, {data[0], data[0]});
+    result = minmaxScalar(his, 4, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+__attribute__((target("sse4.1"))) inline std::pair<double, double> minmaxSse41(const double* data, std::size_t n)
+{
+    __m128d lo = _mm_set1_pd(data[0]), hi = lo;
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d v = _mm_loadu_pd(data + i);
+        lo = _mm_min_pd(lo, v);
+        hi = _mm_max_pd(hi, v);
+    }
+    alignas(16) double los[2], his[2];
+    _mm_store_pd(los, lo);
+    _mm_store_pd(his, hi);
+    std::pair<double, double> result = minmaxScalar(los, 2, {data[0], data[0]});
+    result = minmaxScalar(his, 2, result);
+    return minmaxScalar(data + i, n - i, result);
+}
+
+__attribute__((target("sse4.1"))) inline int eqMask(const int* p, __m128i value)
+{
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), value);
+    return _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+__attribute__((target("sse4.1"))) inline int eqMask(const float* p, __m128 value)
+{
+    return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), value));
+}
+
+__attribute__((target("sse4.1"))) inline int eqMask(const double* p, __m128d value)
+{
+    return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), value));
+}
+
+__attribute__((target("sse4.1"))) inline __m128i splat128(int value)
+{
+    return _mm_set1_epi32(value);
+}
+
+__attribute__((target("sse4.1"))) inline __m128 splat128(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+__attribute__((target("sse4.1"))) inline __m128d splat128(double value)
+{
+    return _mm_set1_pd(value);
+}
+
+template<typename T>
+__attribute__((target("sse4.1,popcnt"))) std::size_t countSse41(const T* data, std::size_t n, T value)
+{
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    auto v = splat128(value);
+    std::size_t count = 0, i = 0;
+    for (; i + lanes <= n; i += lanes)
+        count += __builtin_popcount(eqMask(data + i, v));
+    return count + countScalar(data + i, n - i, value);
+}
+
+template<typename T>
+__attribute__((target("sse4.1"))) std::size_t findSse41(const T* data, std::size_t n, T value)
+{
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    auto v = splat128(value);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+        if (int mask = eqMask(data + i, v))
+            return i + __builtin_ctz(mask);
+    return i + findScalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse4.1"))) inline long long dotSse41(const int* a, const int* b, std::size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(_mm_cvtepi32_epi64(va), _mm_cvtepi32_epi64(vb)));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(_mm_cvtepi32_epi64(_mm_unpackhi_epi64(va, va)),
+                                               _mm_cvtepi32_epi64(_mm_unpackhi_epi64(vb, vb))));
+    }
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline float dotSse41(const float* a, const float* b, std::size_t n)
+{
+    __m128 acc = _mm_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline double dotSse41(const double* a, const double* b, std::size_t n)
+{
+    __m128d acc = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    return hsum(acc) + dotScalar(a + i, b + i, n - i);
+}
+
+#endif
+
+template<typename T>
+inline constexpr bool IsSupported = std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+} // namespace detail
+
+// the instruction set the kernels currently use
+inline Level level()
+{
+    return detail::currentLevel().load(std::memory_order_relaxed);
+}
+
+// force a level, e.g. to compare against Scalar; capped at what the CPU supports
+inline void setLevel(Level level)
+{
+    detail::currentLevel().store(std::min(level, detectLevel()), std::memory_order_relaxed);
+}
+
+template<typename T>
+detail::SumType<T> sum(const T* data, std::size_t n)
+{
+    static_assert(detail::IsSupported<T>, "simd kernels support int, float and double");
+#ifdef MYVEC_SIMD_X86
+    if (level() == Level::AVX2)
+        return detail::sumAvx2(data, n);
+    if (level() == Level::SSE41)
+        return detail::sumSse41(data, n);
+#endif
+    return detail::sumScalar(data, n);
+}
+
+// smallest and largest element, n must not be 0
+template<typename T>
+std::pair<T, T> minmax(const T* data, std::size_t n)
+{
+    static_assert(detail::IsSupported<T>, "simd kernels support int, float and double");
+    if (n == 0)
+        throw std::invalid_argument("minmax of an empty range");
+#ifdef MYVEC_SIMD_X86
+    if (level() == Level::AVX2)
+        return detail::minmaxAvx2(data, n);
+    if (level() == Level::SSE41)
+        return detail::minmaxSse41(data, n);
+#endif
+    return detail::minmaxScalar(data, n, {data[0], data[0]});
+}
+
+template<typename T>
+std::size_t count_eq(const T* data, std::size_t n, T value)
+{
+    static_assert(detail::IsSupported<T>, "simd kernels support int, float and double");
+#ifdef MYVEC_SIMD_X86
+    if (level() == Level::AVX2)
+        return detail::countAvx2(data, n, value);
+    if (level() == Level::SSE41)
+        return detail::countSse41(data, n, value);
+#endif
+    return detail::countScalar(data, n, value);
+}
+
+// index of the first element equal to value, n if there is none
+template<typename T>
+std::size_t find_first(const T* data, std::size_t n, T value)
+{
+    static_assert(detail::IsSupported<T>, "simd kernels support int, float and double");
+#ifdef MYVEC_SIMD_X86
+    if (level() == Level::AVX2)
+        return detail::findAvx2(data, n, value);
+    if (level() == Level::SSE41)
+        return detail::findSse41(data, n, value);
+#endif
+    return detail::findScalar(data, n, value);
+}
+
+template<typename T>
+detail::SumType<T> dot(const T* a, const T* b, std::size_t n)
+{
+    static_assert(detail::IsSupported<T>, "simd kernels support int, float and double");
+#ifdef MYVEC_SIMD_X86
+    if (level() == Level::AVX2)
+        return detail::dotAvx2(a, b, n);
+    if (level() == Level::SSE41)
+        return detail::dotSse41(a, b, n);
+#endif
+    return detail::dotScalar(a, b, n);
+}
+
+template<typename T, typename... Rest>
+detail::SumType<T> sum(const MyVector<T, Rest...>& v)
+{
+    return sum(v.data(), v.size());
+}
+
+template<typename T, typename... Rest>
+std::pair<T, T> minmax(const MyVector<T, Rest...>& v)
+{
+    return minmax(v.data(), v.size());
+}
+
+template<typename T, typename... Rest>
+std::size_t count_eq(const MyVector<T, Rest...>& v, T value)
+{
+    return count_eq(v.data(), v.size(), value);
+}
+
+template<typename T, typename... Rest>
+std::size_t find_first(const MyVector<T, Rest...>& v, T value)
+{
+    return find_first(v.data(), v.size(), value);
+}
+
+// dot product over the shorter of the two vectors
+template<typename T, typename... Rest>
+detail::SumType<T> dot(const MyVector<T, Rest...>& a, const MyVector<T, Rest...>& b)
+{
+    return dot(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+} // namespace myvec::simd
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+
+// Allocation and copy counters for MyVector. Compile with -DMYVECTOR_STATS to
+// turn them on; otherwise every hook is an empty inline call and the
+// per-instance counter takes no space.
+//
+// The macro changes the layout of every MyVector, so it must be set the same
+// way in every translation unit of a program, best on the command line.
+// Mixing the two settings breaks the one-definition rule and nothing
+// diagnoses it.
+#ifdef MYVECTOR_STATS
+inline constexpr bool MyVectorStatsEnabled = true;
+#else
+inline constexpr bool MyVectorStatsEnabled = false;
+#endif
+
+struct MyVectorStats
+{
+    std::size_t resizes = 0;         // capacity changes, by reallocate() or a growing insert
+    std::size_t allocations = 0;     // buffers allocated or reallocated
+    std::size_t bytesAllocated = 0;  // sum of the sizes of those buffers
+    std::size_t elementsMoved = 0;   // elements relocated by transfer() with memcpy or a noexcept move
+    std::size_t elementsCopied = 0;  // elements copied by copy(), copyRange() and transfer() when moving could throw
+    std::size_t elementsShifted = 0; // elements shifted by insert and remove
+
+    void dump(std::ostream& out, const char* label = "MyVector") const
+    {
+        out << label << ": resizes=" << resizes
+            << " allocations=" << allocations
+            << " bytesAllocated=" << bytesAllocated
+            << " elementsMoved=" << elementsMoved
+            << " elementsCopied=" << elementsCopied
+            << " elementsShifted=" << elementsShifted << '\n';
+    }
+
+    // totals over every MyVector in the process
+    static MyVectorStats global();
+
+    static void resetGlobal();
+
+    // print the global totals to stderr when the process exits
+    static void dumpAtExit()
+    {
+        std::atexit([] { global().dump(std::cerr, "MyVector totals"); });
+    }
+};
+
+struct MyVectorGlobalStats
+{
+    static inline std::atomic<std::size_t> resizes{0};
+    static inline std::atomic<std::size_t> allocations{0};
+    static inline std::atomic<std::size_t> bytesAllocated{0};
+    static inline std::atomic<std::size_t> elementsMoved{0};
+    static inline std::atomic<std::size_t> elementsCopied{0};
+    static inline std::atomic<std::size_t> elementsShifted{0};
+};
+
+inline MyVectorStats MyVectorStats::global()
+{
+    MyVectorStats stats;
+    stats.resizes = MyVectorGlobalStats::resizes.load(std::memory_order_relaxed);
+    stats.allocations = MyVectorGlobalStats::allocations.load(std::memory_order_relaxed);
+    stats.bytesAllocated = MyVectorGlobalStats::bytesAllocated.load(std::memory_order_relaxed);
+    stats.elementsMoved = MyVectorGlobalStats::elementsMoved.load(std::memory_order_relaxed);
+    stats.elementsCopied = MyVectorGlobalStats::elementsCopied.load(std::memory_order_relaxed);
+    stats.elementsShifted = MyVectorGlobalStats::elementsShifted.load(std::memory_order_relaxed);
+    return stats;
+}
+
+inline void MyVectorStats::resetGlobal()
+{
+    MyVectorGlobalStats::resizes = 0;
+    MyVectorGlobalStats::allocations = 0;
+    MyVectorGlobalStats::bytesAllocated = 0;
+    MyVectorGlobalStats::elementsMoved = 0;
+    MyVectorGlobalStats::elementsCopied = 0;
+    MyVectorGlobalStats::elementsShifted = 0;
+}
+
+// The hooks MyVector calls, one instance per vector.
+template<bool Enabled = MyVectorStatsEnabled>
+class MyVectorStatsCounter
+{
+public:
+    void resized() {}
+    void allocated(std::size_t) {}
+    void moved(std::size_t) {}
+    void copied(std::size_t) {}
+    void shifted(std::size_t) {}
+
+    MyVectorStats get() const
+    {
+        return {};
+    }
+};
+
+template<>
+class MyVectorStatsCounter<true>
+{
+private:
+    MyVectorStats m_Stats;
+
+    static void add(std::atomic<std::size_t>& total, std::size_t& local, std::size_t n)
+    {
+        local += n;
+        total.fetch_add(n, std::memory_order_relaxed);
+    }
+
+public:
+    MyVectorStatsCounter()
+    {
+    }
+
+    // a copied or moved-to vector starts counting from zero
+    MyVectorStatsCounter(const MyVectorStatsCounter&)
+    {
+    }
+
+    MyVectorStatsCounter& operator=(const MyVectorStatsCounter&)
+    {
+        return *this;
+    }
+
+    void resized()
+    {
+        add(MyVectorGlobalStats::resizes, m_Stats.resizes, 1);
+    }
+
+    void allocated(std::size_t bytes)
+    {
+        add(MyVectorGlobalStats::allocations, m_Stats.allocations, 1);
+        add(MyVectorGlobalStats::bytesAllocated, m_Stats.bytesAllocated, bytes);
+    }
+
+    void moved(std::size_t count)
+    {
+        add(MyVectorGlobalStats::elementsMoved, m_Stats.elementsMoved, count);
+    }
+
+    void copied(std::size_t count)
+    {
+        add(MyVectorGlobalStats::elementsCopied, m_Stats.elementsCopied, count);
+    }
+
+    void shifted(std::size_t count)
+    {
+        add(MyVectorGlobalStats::elementsShifted, m_Stats.elementsShifted, count);
+    }
+
+    MyVectorStats get() const
+    {
+        return m_Stats;
+    }
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "MyVector.hpp"
+
+// Non-owning view of contiguous elements: a pointer and a length. Views
+// convert implicitly from MyVector and std::span and back to std::span, so
+// functions can take a slice of a vector without copying it. Use
+// MyVectorView<const T> for read-only access.
+//
+// A view does not keep the vector alive, and growing the vector may move its
+// buffer, which leaves the view dangling.
+template <typename T>
+class MyVectorView
+{
+private:
+    T* m_Data = nullptr;
+    std::size_t m_Size = 0;
+
+public:
+    using ValueType = std::remove_cv_t<T>;
+    using Iterator = MyVectorIterator<MyVectorView, std::is_const_v<T>>;
+
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    MyVectorView()
+    {
+    }
+
+    MyVectorView(T* data, std::size_t size)
+        : m_Data(data),
+        m_Size(size)
+    {
+    }
+
+    // MyVector<int> converts to MyVectorView<int> and MyVectorView<const int>
+    template<typename U, typename... Rest>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    MyVectorView(MyVector<U, Rest...>& array)
+        : MyVectorView(array.data(), array.size())
+    {
+    }
+
+    template<typename U, typename... Rest>
+        requires std::is_convertible_v<const U (*)[], T (*)[]>
+    MyVectorView(const MyVector<U, Rest...>& array)
+        : MyVectorView(array.data(), array.size())
+    {
+    }
+
+    template<typename U, std::size_t Extent>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    MyVectorView(std::span<U, Extent> span)
+        : MyVectorView(span.data(), span.size())
+    {
+    }
+
+    // a view of mutable elements converts to a view of const ones
+    template<typename U>
+        requires (!std::is_same_v<U, T> && std::is_convertible_v<U (*)[], T (*)[]>)
+    MyVectorView(const MyVectorView<U>& other)
+        : MyVectorView(other.data(), other.size())
+    {
+    }
+
+    operator std::span<T>() const
+    {
+        return std::span<T>(m_Data, m_Size);
+    }
+
+    std::span<T> span() const
+    {
+        return *this;
+    }
+
+    T& operator[](const std::size_t& index) const
+    {
+        return m_Data[index];
+    }
+
+    T& at(const std::size_t& index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of bound");
+
+        return m_Data[index];
+    }
+
+    // count elements starting at offset, or up to the end by default
+    MyVectorView subview(const std::size_t& offset, const std::size_t& count = npos) const
+    {
+        if (offset > size())
+            throw std::out_of_range("Index out of bound");
+
+        return MyVectorView(m_Data + offset, std::min(count, size() - offset));
+    }
+
+    // the first count elements
+    MyVectorView first(const std::size_t& count) const
+    {
+        if (count > size())
+            throw std::out_of_range("Index out of bound");
+
+        return MyVectorView(m_Data, count);
+    }
+
+    // the last count elements
+    MyVectorView last(const std::size_t& count) const
+    {
+        if (count > size())
+            throw std::out_of_range("Index out of bound");
+
+        return MyVectorView(m_Data + size() - count, count);
+    }
+
+    T* data() const
+    {
+        return m_Data;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(m_Data);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(m_Data + m_Size);
+    }
+
+    T& front() const
+    {
+        return at(0);
+    }
+
+    T& back() const
+    {
+        return at(size() - 1);
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    std::size_t size() const
+    {
+        return m_Size;
+    }
+};
+
+template<typename T, typename... Rest>
+MyVectorView(MyVector<T, Rest...>&) -> MyVectorView<T>;
+
+template<typename T, typename... Rest>
+MyVectorView(const MyVector<T, Rest...>&) -> MyVectorView<const T>;
+
+template<typename T, std::size_t Extent>
+MyVectorView(std::span<T, Extent>) -> MyVectorView<T>;
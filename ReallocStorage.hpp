@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// buffers of at least this many bytes are anonymous mappings grown with mremap
+#ifndef MYVECTOR_MREMAP_THRESHOLD
+#define MYVECTOR_MREMAP_THRESHOLD (std::size_t(64) << 20)
+#endif
+
+// Raw storage for trivially relocatable elements. Small buffers come from
+// malloc and grow with realloc, large ones are mmap'd and grow with mremap, so
+// in the common case growing a buffer does not copy it or double peak memory.
+// Which of the two a buffer is comes from its size, so callers must pass the
+// same byte count back that they allocated.
+struct ReallocStorage
+{
+    static bool isMapped(std::size_t bytes)
+    {
+        return bytes >= MYVECTOR_MREMAP_THRESHOLD;
+    }
+
+    static std::size_t pageRound(std::size_t bytes)
+    {
+        static const std::size_t page = sysconf(_SC_PAGESIZE);
+        return (bytes + page - 1) / page * page;
+    }
+
+    // callers check their element count, this only keeps pageRound from wrapping
+    static void checkBytes(std::size_t bytes)
+    {
+        if (bytes > std::size_t(PTRDIFF_MAX))
+            throw std::bad_alloc();
+    }
+
+    static void* allocate(std::size_t bytes)
+    {
+        if (bytes == 0)
+            return nullptr;
+        checkBytes(bytes);
+
+        void* p;
+        if (isMapped(bytes))
+        {
+            p = mmap(nullptr, pageRound(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+        }
+        else
+        {
+            p = std::malloc(bytes);
+            if (!p)
+                throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    static void deallocate(void* p, std::size_t bytes)
+    {
+        if (!p)
+            return;
+
+        if (isMapped(bytes))
+            munmap(p, pageRound(bytes));
+        else
+            std::free(p);
+    }
+
+    // grow or shrink a buffer, keeping the first `used` bytes
+    static void* reallocate(void* p, std::size_t oldBytes, std::size_t newBytes, std::size_t used)
+    {
+        if (!p)
+            return allocate(newBytes);
+
+        if (newBytes == 0)
+        {
+            deallocate(p, oldBytes);
+            return nullptr;
+        }
+        checkBytes(newBytes);
+
+        if (isMapped(oldBytes) && isMapped(newBytes))
+        {
+#ifdef __linux__
+            void* q = mremap(p, pageRound(oldBytes), pageRound(newBytes), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED)
+                throw std::bad_alloc();
+            return q;
+#endif
+        }
+        else if (!isMapped(oldBytes) && !isMapped(newBytes))
+        {
+            void* q = std::realloc(p, newBytes);
+            if (!q)
+                throw std::bad_alloc();
+            return q;
+        }
+
+        // crossing the threshold, or no mremap on this platform
+        void* q = allocate(newBytes);
+        std::memcpy(q, p, used);
+        deallocate(p, oldBytes);
+        return q;
+    }
+};
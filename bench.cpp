@@ -0,0 +1,1331 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Bench.hpp"
+#include "MyVector.hpp"
+#include "MySmallVector.hpp"
+#include "MyConcurrentVector.hpp"
+#include "MySegmentedVector.hpp"
+#include "MySoAVector.hpp"
+#include "MyVectorSimd.hpp"
+#include "MyVectorParallel.hpp"
+#include "MyMappedVector.hpp"
+#include "MyVectorSerialize.hpp"
+#include "MyVectorView.hpp"
+#include "MyCowVector.hpp"
+#include "MyPersistentVector.hpp"
+
+// Count every heap allocation in the program. operator new, MyVector's
+// realloc storage and std::vector all end up in these (glibc only; buffers
+// MyVector maps directly with mmap are not counted).
+extern "C"
+{
+void* __libc_malloc(std::size_t bytes);
+void* __libc_calloc(std::size_t count, std::size_t bytes);
+void* __libc_realloc(void* p, std::size_t bytes);
+
+void* malloc(std::size_t bytes) noexcept
+{
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(bytes);
+}
+
+void* calloc(std::size_t count, std::size_t bytes) noexcept
+{
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, bytes);
+}
+
+void* realloc(void* p, std::size_t bytes) noexcept
+{
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, bytes);
+}
+}
+
+// Append 1M ints under each growth policy and report how often the buffer
+// was reallocated and how many bytes were moved into the new buffers.
+template<typename Policy>
+void benchGrowth(const std::string& name, std::size_t count)
+{
+    MyVector<int, Policy> arr;
+    std::size_t reallocs = 0;
+    std::size_t bytesCopied = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::size_t cap = arr.capacity();
+        std::size_t size = arr.size();
+        arr.push_back(static_cast<int>(i));
+        if (arr.capacity() != cap)
+        {
+            ++reallocs;
+            bytesCopied += size * sizeof(int);
+        }
+    }
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << reallocs
+              << std::setw(16) << bytesCopied
+              << std::setw(12) << arr.capacity() << '\n';
+}
+
+struct Pod64
+{
+    long long fields[8];
+};
+
+// same layout, but forced down the element-by-element move path
+template<typename T>
+struct NotRelocatable
+{
+    T value;
+};
+
+template<typename T>
+struct is_trivially_relocatable<NotRelocatable<T>> : std::false_type {};
+
+// ns per push_back for `count` appends
+template<typename T>
+double benchPushBack(std::size_t count)
+{
+    auto start = std::chrono::steady_clock::now();
+    MyVector<T> arr;
+    for (std::size_t i = 0; i < count; i++)
+        arr.push_back(T{});
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / count;
+}
+
+template<typename T>
+void benchRelocation(const std::string& name, std::size_t count)
+{
+    double slow = benchPushBack<NotRelocatable<T>>(count);
+    double fast = benchPushBack<T>(count);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << slow << std::setw(12) << fast << '\n';
+}
+
+// Grow a vector to `bytes` in a child process so ru_maxrss is that run's peak.
+template<typename T>
+void benchLargeGrowth(const std::string& name, std::size_t bytes)
+{
+    std::cout.flush();
+    if (fork() == 0)
+    {
+        const std::size_t count = bytes / sizeof(T);
+        double worst = 0;
+        auto start = std::chrono::steady_clock::now();
+        MyVector<T> arr;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            std::size_t cap = arr.capacity();
+            auto before = std::chrono::steady_clock::now();
+            arr.push_back(T{});
+            if (arr.capacity() != cap)
+                worst = std::max(worst, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - before).count());
+        }
+        double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << usage.ru_maxrss / 1024 << std::setw(14) << worst
+                  << std::setw(12) << total << '\n';
+        std::exit(0);
+    }
+    wait(nullptr);
+}
+
+// build `count` short-lived 16-element vectors, ns per vector
+template<typename Vector, typename... Args>
+double benchShortLived(std::size_t count, Args&&... args)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Vector arr(args...);
+        for (int j = 0; j < 16; j++)
+            arr.push_back(j);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / count;
+}
+
+// build `count` vectors of `elements` elements, allocations per vector
+template<typename Vector>
+double benchAllocations(std::size_t count, int elements)
+{
+    std::size_t before = g_Allocations;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        Vector arr;
+        for (int j = 0; j < elements; j++)
+            arr.emplace_back(typename Vector::ValueType{j});
+        arr.insert(0, typename Vector::ValueType{-1});
+        arr.remove(0);
+    }
+    return double(g_Allocations - before) / count;
+}
+
+// construct and destroy `count` empty vectors, ns and allocations per vector
+template<typename Vector, typename... Args>
+void benchEmpty(const std::string& name, std::size_t count, Args... args)
+{
+    std::size_t before = g_Allocations;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<Vector> vectors;
+        vectors.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+            vectors.emplace_back(args...);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << std::chrono::duration<double, std::nano>(stop - start).count() / count
+              << std::setw(12) << double(g_Allocations - before - 1) / count << '\n';
+}
+
+// load `count` ints from a plain array, push_back loop vs append
+void benchBulkLoad(std::size_t count)
+{
+    std::vector<int> source(count, 7);
+
+    auto start = std::chrono::steady_clock::now();
+    MyVector<int> pushed;
+    for (int value : source)
+        pushed.push_back(value);
+    auto middle = std::chrono::steady_clock::now();
+    MyVector<int> appended;
+    appended.append(source.data(), source.size());
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << std::left << std::setw(24) << "bulk load ns/element"
+              << std::right << std::setw(12) << "push_back"
+              << std::setw(12) << "append" << '\n'
+              << std::setw(24) << "" << std::setw(12) << std::chrono::duration<double, std::nano>(middle - start).count() / count
+              << std::setw(12) << std::chrono::duration<double, std::nano>(stop - middle).count() / count << '\n';
+}
+
+// delete every 10th element, ns per removed element
+template<typename Remove>
+double benchRemoval(std::size_t count, Remove removeTenth)
+{
+    MyVector<int> arr;
+    for (std::size_t i = 0; i < count; i++)
+        arr.push_back(static_cast<int>(i));
+    auto start = std::chrono::steady_clock::now();
+    removeTenth(arr);
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (count / 10);
+}
+
+void benchRemovals()
+{
+    const std::size_t SMALL = 100000, LARGE = 10000000;
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < LARGE; i += 10)
+        indices.push_back(i);
+
+    std::cout << std::left << std::setw(24) << "remove 10% ns/element"
+              << std::right << std::setw(12) << "100K" << std::setw(12) << "10M" << '\n';
+    double loop = benchRemoval(SMALL, [](MyVector<int>& arr) {
+        for (std::size_t i = arr.size() / 10; i-- > 0;)
+            arr.remove(i * 10);
+    });
+    std::cout << std::left << std::setw(24) << "remove() loop" << std::right
+              << std::setw(12) << loop << std::setw(12) << "-" << '\n';
+
+    auto erase = [](MyVector<int>& arr) { arr.erase_if([](int x) { return x % 10 == 0; }); };
+    auto indexed = [&](MyVector<int>& arr) { arr.remove_indices(indices.data(), arr.size() / 10); };
+    std::cout << std::left << std::setw(24) << "erase_if" << std::right
+              << std::setw(12) << benchRemoval(SMALL, erase) << std::setw(12) << benchRemoval(LARGE, erase) << '\n';
+    std::cout << std::left << std::setw(24) << "remove_indices" << std::right
+              << std::setw(12) << benchRemoval(SMALL, indexed) << std::setw(12) << benchRemoval(LARGE, indexed) << '\n';
+}
+
+// remove 1000 elements from the middle of a `count` element vector, ns per removal
+template<typename Remove>
+double benchMiddleRemoval(std::size_t count, Remove removeAt)
+{
+    const std::size_t REMOVALS = 1000;
+    MyVector<int> arr;
+    for (std::size_t i = 0; i < count + REMOVALS; i++)
+        arr.push_back(static_cast<int>(i));
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < REMOVALS; i++)
+        removeAt(arr, arr.size() / 2);
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / REMOVALS;
+}
+
+void benchSwapRemove()
+{
+    std::cout << std::left << std::setw(24) << "middle removal ns"
+              << std::right << std::setw(12) << "remove" << std::setw(12) << "swap_remove" << '\n';
+    for (std::size_t count : {1000, 100000, 10000000})
+    {
+        double shifted = benchMiddleRemoval(count, [](MyVector<int>& arr, std::size_t i) { arr.remove(i); });
+        double swapped = benchMiddleRemoval(count, [](MyVector<int>& arr, std::size_t i) { arr.swap_remove(i); });
+        std::cout << std::left << std::setw(24) << (std::to_string(count) + " elements") << std::right
+                  << std::setw(12) << shifted << std::setw(12) << swapped << '\n';
+    }
+}
+
+// std::sort and std::copy over MyVector iterators vs std::vector, ns per element
+void benchAlgorithms(std::size_t count)
+{
+    std::vector<int> source(count);
+    for (std::size_t i = 0; i < count; i++)
+        source[i] = static_cast<int>((i * 2654435761u) % count);
+
+    MyVector<int> arr;
+    arr.append(source.data(), source.size());
+    std::vector<int> vec = source;
+
+    auto time = [count](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    };
+    double sortMine = time([&] { std::sort(arr.begin(), arr.end()); });
+    double sortStd = time([&] { std::sort(vec.begin(), vec.end()); });
+    MyVector<int> arrOut(count);
+    std::vector<int> vecOut(count);
+    arrOut.append(source.data(), count);
+    double copyMine = time([&] { std::copy(arr.cbegin(), arr.cend(), arrOut.begin()); });
+    double copyStd = time([&] { std::copy(vec.cbegin(), vec.cend(), vecOut.begin()); });
+
+    std::cout << std::left << std::setw(24) << "algorithms ns/element"
+              << std::right << std::setw(12) << "MyVector" << std::setw(12) << "std::vector" << '\n'
+              << std::left << std::setw(24) << "std::sort" << std::right << std::setw(12) << sortMine << std::setw(12) << sortStd << '\n'
+              << std::left << std::setw(24) << "std::copy" << std::right << std::setw(12) << copyMine << std::setw(12) << copyStd << '\n';
+}
+
+// `threads` writers append `total` ints between them, million appends per second
+template<typename Append>
+double benchAppendThreads(std::size_t threads, std::size_t total, Append append)
+{
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; t++)
+        workers.emplace_back([&, t] {
+            for (std::size_t i = t; i < total; i += threads)
+                append(static_cast<int>(i));
+        });
+    for (auto& worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total / seconds / 1e6;
+}
+
+void benchConcurrentScaling(std::size_t total)
+{
+    std::cout << std::left << std::setw(24) << "appends Mops/s"
+              << std::right << std::setw(12) << "lock-free" << std::setw(12) << "mutex" << '\n';
+    for (std::size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        MyConcurrentVector<int> concurrent;
+        double lockFree = benchAppendThreads(threads, total, [&](int i) { concurrent.push_back(i); });
+
+        MyVector<int> locked;
+        std::mutex mutex;
+        double withMutex = benchAppendThreads(threads, total, [&](int i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.push_back(i);
+        });
+        std::cout << std::left << std::setw(24) << (std::to_string(threads) + " threads") << std::right
+                  << std::setw(12) << lockFree << std::setw(12) << withMutex << '\n';
+    }
+}
+
+struct Record
+{
+    double price;
+    long id;
+    long timestamp;
+    int quantity;
+    int flags;
+};
+
+// sum one field over `rows` records stored as structs and as columns, GB/s of records scanned
+void benchSoA(std::size_t rows)
+{
+    auto time = [](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        double sum = fn();
+        doNotOptimize(sum);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double aos, soa;
+    {
+        MyVector<Record> records;
+        for (std::size_t i = 0; i < rows; i++)
+            records.push_back(Record{double(i % 100), long(i), long(i), int(i), 0});
+        aos = time([&] {
+            double sum = 0;
+            for (const Record& r : records)
+                sum += r.price;
+            return sum;
+        });
+    }
+    {
+        MySoAVector<double, long, long, int, int> records;
+        for (std::size_t i = 0; i < rows; i++)
+            records.emplace_back(double(i % 100), long(i), long(i), int(i), 0);
+        soa = time([&] {
+            double sum = 0;
+            for (double price : records.column<0>())
+                sum += price;
+            return sum;
+        });
+    }
+    std::cout << std::left << std::setw(24) << "sum 1 field ms" << std::right
+              << std::setw(12) << "AoS" << std::setw(12) << "SoA" << '\n'
+              << std::left << std::setw(24) << (std::to_string(rows) + " rows") << std::right
+              << std::setw(12) << aos * 1e3 << std::setw(12) << soa * 1e3 << '\n';
+}
+
+// GB/s read by each simd kernel at every level the CPU supports
+template<typename T>
+void benchSimd(const char* type, std::size_t count)
+{
+    using namespace myvec::simd;
+    MyVector<T> a, b;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        a.push_back(T(i % 1000));
+        b.push_back(T(i % 7));
+    }
+
+    auto gbps = [&](std::size_t bytes, auto&& fn) {
+        const int REPEAT = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEAT; r++)
+            doNotOptimize(fn());
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return bytes * REPEAT / seconds / 1e9;
+    };
+
+    const std::size_t bytes = count * sizeof(T);
+    const Level best = level();
+    for (Level l : {Level::Scalar, Level::SSE41, Level::AVX2})
+    {
+        setLevel(l);
+        if (level() != l)
+            continue;
+        const char* name = l == Level::Scalar ? "scalar" : l == Level::SSE41 ? "sse4.1" : "avx2";
+        std::cout << std::left << std::setw(24) << (std::string(type) + " " + name) << std::right
+                  << std::setw(10) << gbps(bytes, [&] { return sum(a); })
+                  << std::setw(10) << gbps(bytes, [&] { return minmax(a).second; })
+                  << std::setw(10) << gbps(bytes, [&] { return count_eq(a, T(3)); })
+                  << std::setw(10) << gbps(bytes, [&] { return find_first(a, T(-1)); })
+                  << std::setw(10) << gbps(bytes * 2, [&] { return dot(a, b); }) << '\n';
+    }
+    setLevel(best);
+}
+
+// ms for each parallel algorithm over `count` doubles, per pool size
+void benchParallelScaling(std::size_t count)
+{
+    using namespace myvec::parallel;
+    auto ms = [](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+    };
+
+    MyVector<double> source;
+    for (std::size_t i = 0; i < count; i++)
+        source.push_back(double((i * 7919) % 1000003));
+
+    std::cout << std::left << std::setw(24) << "ms" << std::right
+              << std::setw(12) << "for" << std::setw(12) << "transform"
+              << std::setw(12) << "reduce" << std::setw(12) << "sort" << '\n'
+              << "(" << std::thread::hardware_concurrency() << " hardware threads)\n";
+    for (std::size_t threads = 1; threads <= 16; threads *= 2)
+    {
+        ThreadPool pool(threads);
+        MyVector<double> v(source);
+        MyVector<double> out(source);
+        double forMs = ms([&] { parallel_for(v, [](double& x) { x = x * 1.5 + 1; }, pool); });
+        double transformMs = ms([&] { parallel_transform(v, out, [](double x) { return x * x; }, pool); });
+        double sum = 0;
+        double reduceMs = ms([&] { sum = parallel_reduce(v, 0.0, std::plus<>(), pool); });
+        doNotOptimize(sum);
+        double sortMs = ms([&] { parallel_sort(out, std::less<>(), pool); });
+        std::cout << std::left << std::setw(24) << (std::to_string(threads) + " threads") << std::right
+                  << std::setw(12) << forMs << std::setw(12) << transformMs
+                  << std::setw(12) << reduceMs << std::setw(12) << sortMs << '\n';
+    }
+}
+
+// drop a file's pages from the page cache so the next read comes from disk
+void evictFile(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// load `rows` records saved in a file: read + push_back against mapping it
+void benchColdLoad(std::size_t rows)
+{
+    const std::string path = "/tmp/mymappedvector_bench." + std::to_string(getpid());
+    {
+        MyMappedVector<Record> records(path);
+        records.reserve(rows);
+        for (std::size_t i = 0; i < rows; i++)
+            records.push_back(Record{double(i % 100), long(i), long(i), int(i), 0});
+    }
+    auto ms = [](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+    };
+    auto sum = [](const auto& records) {
+        double total = 0;
+        for (const Record& r : records)
+            total += r.price;
+        doNotOptimize(total);
+    };
+
+    evictFile(path);
+    double readMs = ms([&] {
+        std::ifstream in(path, std::ios::binary);
+        MyVector<Record> records;
+        Record buffer[4096];
+        while (in.read(reinterpret_cast<char*>(buffer), sizeof(buffer)) || in.gcount())
+        {
+            for (std::size_t i = 0; i < std::size_t(in.gcount()) / sizeof(Record); i++)
+                records.push_back(buffer[i]);
+        }
+        sum(records);
+    });
+
+    evictFile(path);
+    double openMs = 0;
+    double mapMs = ms([&] {
+        openMs = ms([&] { MyMappedVector<Record> records(path, MapMode::ReadOnly); });
+        MyMappedVector<Record> records(path, MapMode::ReadOnly);
+        sum(records);
+    });
+    std::remove(path.c_str());
+
+    std::cout << std::left << std::setw(24) << "cold load ms" << std::right
+              << std::setw(16) << "read+push_back" << std::setw(12) << "mmap open"
+              << std::setw(14) << "mmap + scan" << '\n'
+              << std::left << std::setw(24) << (std::to_string(rows) + " records") << std::right
+              << std::setw(16) << readMs << std::setw(12) << openMs << std::setw(14) << mapMs << '\n';
+}
+
+// GB/s saving and loading `count` doubles: per element, serialize/deserialize, mapped view
+void benchSerialize(std::size_t count)
+{
+    const std::string path = "/tmp/myvector_serial_bench." + std::to_string(getpid());
+    MyVector<double> values;
+    for (std::size_t i = 0; i < count; i++)
+        values.push_back(double(i) / 3);
+    const double gb = count * sizeof(double) / 1e9;
+    auto gbps = [&](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return gb / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double elementwise = gbps([&] {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (double value : values)
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    });
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    double save = gbps([&] { myvec::serialize(values, fd); });
+    double load = gbps([&] {
+        lseek(fd, 0, SEEK_SET);
+        MyVector<double> loaded = myvec::deserialize<double>(fd);
+        doNotOptimize(loaded.data());
+    });
+    double mapped = gbps([&] {
+        myvec::MappedView<double> view(fd);
+        doNotOptimize(view.data());
+    });
+    double unverified = gbps([&] {
+        myvec::MappedView<double> view(fd, false);
+        doNotOptimize(view.data());
+    });
+    close(fd);
+    std::remove(path.c_str());
+
+    std::cout << std::left << std::setw(24) << "GB/s" << std::right
+              << std::setw(12) << "per elem" << std::setw(12) << "serialize" << std::setw(12) << "deserialize"
+              << std::setw(12) << "view" << std::setw(14) << "view no-crc" << '\n'
+              << std::left << std::setw(24) << (std::to_string(count) + " doubles") << std::right
+              << std::setw(12) << elementwise << std::setw(12) << save << std::setw(12) << load
+              << std::setw(12) << mapped << std::setw(14) << unverified << '\n';
+}
+
+long sumSlice(MyVectorView<const long> values)
+{
+    long sum = 0;
+    for (long v : values)
+        sum += v;
+    return sum;
+}
+
+// hand every `width`-element slice of a vector to a function: copy into a MyVector vs pass a view
+void benchSlices(std::size_t count, std::size_t width)
+{
+    MyVector<long> values;
+    for (std::size_t i = 0; i < count; i++)
+        values.push_back(long(i));
+    auto ns = [&](auto&& slice) {
+        g_Allocations = 0;
+        auto start = std::chrono::steady_clock::now();
+        long total = 0;
+        for (std::size_t i = 0; i + width <= count; i += width)
+            total += slice(i);
+        doNotOptimize(total);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (count / width);
+    };
+
+    double copied = ns([&](std::size_t i) {
+        MyVector<long> copy;
+        copy.append(values.data() + i, width);
+        return sumSlice(copy);
+    });
+    std::size_t copyAllocs = g_Allocations;
+    double viewed = ns([&](std::size_t i) { return sumSlice(MyVectorView(values).subview(i, width)); });
+    std::size_t viewAllocs = g_Allocations;
+
+    std::cout << std::left << std::setw(24) << (std::to_string(width) + " elements") << std::right
+              << std::setw(12) << copied << std::setw(12) << viewed
+              << std::setw(14) << copyAllocs << std::setw(14) << viewAllocs << '\n';
+}
+
+// a string whose move constructor is or isn't noexcept, counting its copies
+template<bool NothrowMove>
+struct Text
+{
+    static inline std::size_t copies = 0;
+    std::string s;
+
+    Text(std::string value) : s(std::move(value)) {}
+    Text(const Text& other) : s(other.s) { ++copies; }
+    Text(Text&& other) noexcept(NothrowMove) : s(std::move(other.s)) {}
+    Text& operator=(const Text&) = default;
+    Text& operator=(Text&&) = default;
+};
+
+// what the strong guarantee costs: noexcept types keep moving, others copy on growth
+template<bool NothrowMove>
+void benchExceptionSafety(const char* name, std::size_t count)
+{
+    using T = Text<NothrowMove>;
+    const std::string value = "a string too long for the small buffer";
+    T::copies = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        MyVector<T> v;
+        for (std::size_t i = 0; i < count; i++)
+            v.emplace_back(value);
+        doNotOptimize(v.data());
+    }
+    double pushNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    double pushCopies = double(T::copies) / count;
+
+    const std::size_t inserts = 1000;
+    MyVector<T> v;
+    for (std::size_t i = 0; i < count / 100; i++)
+        v.emplace_back(value);
+    T::copies = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < inserts; i++)
+        v.insert(v.size() / 2, T(value));
+    double insertNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / inserts;
+
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << pushNs << std::setw(14) << pushCopies
+              << std::setw(12) << insertNs << std::setw(14) << double(T::copies) / inserts << '\n';
+}
+
+// decode `count` values into a fresh vector four ways, ns per element
+void benchDecode(std::size_t count)
+{
+    auto decode = [](std::size_t i) { return unsigned(i * 2654435761u) >> 3; };
+    auto ns = [&](auto&& fill) {
+        auto start = std::chrono::steady_clock::now();
+        MyVector<unsigned> v;
+        fill(v);
+        doNotOptimize(v.data());
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    };
+
+    double pushed = ns([&](MyVector<unsigned>& v) {
+        for (std::size_t i = 0; i < count; i++)
+            v.push_back(decode(i));
+    });
+    double reserved = ns([&](MyVector<unsigned>& v) {
+        v.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+            v.push_back(decode(i));
+    });
+    double zeroed = ns([&](MyVector<unsigned>& v) {
+        v.resize(count);
+        for (std::size_t i = 0; i < count; i++)
+            v.data()[i] = decode(i);
+    });
+    double uninitialized = ns([&](MyVector<unsigned>& v) {
+        v.resize_uninitialized(count);
+        for (std::size_t i = 0; i < count; i++)
+            v.data()[i] = decode(i);
+    });
+
+    std::cout << std::left << std::setw(24) << "decode ns/element" << std::right
+              << std::setw(12) << "push_back" << std::setw(12) << "reserve"
+              << std::setw(12) << "resize" << std::setw(14) << "uninitialized" << '\n'
+              << std::setw(24) << "" << std::setw(12) << pushed << std::setw(12) << reserved
+              << std::setw(12) << zeroed << std::setw(14) << uninitialized << '\n';
+}
+
+// A writer changes a few elements and publishes a snapshot every tick while
+// `readers` threads keep taking the latest snapshot and summing it.
+template<typename Vector>
+void benchSnapshots(const char* name, std::size_t count, int readers)
+{
+    const int TICKS = 200;
+    Vector current;
+    for (std::size_t i = 0; i < count; i++)
+        current.push_back(long(i));
+    Vector published = current;
+    std::mutex mutex;
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> reads{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++)
+    {
+        threads.emplace_back([&] {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                Vector snapshot;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    snapshot = published;
+                }
+                long total = 0;
+                for (long value : std::as_const(snapshot))
+                    total += value;
+                doNotOptimize(total);
+                reads++;
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < TICKS; tick++)
+    {
+        for (std::size_t k = 0; k < 16; k++)
+            current[(tick * 16 + k) * 7919 % count] += 1;
+        std::lock_guard<std::mutex> lock(mutex);
+        published = current;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::cout << std::left << std::setw(24) << (std::string(name) + ", " + std::to_string(readers) + " readers")
+              << std::right << std::setw(12) << TICKS / seconds << std::setw(14) << reads / seconds << '\n';
+}
+
+// bytes held by malloc right now, including its large mmap'd blocks
+std::size_t heapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+// Keep a version history of a `count`-element vector: what each update
+// costs and how much memory each kept version adds, against copying a
+// MyVector per version.
+void benchPersistent(std::size_t count)
+{
+    const std::size_t UPDATES = 100000;
+    const std::size_t KEPT = 2000;
+    auto nsPer = [](std::size_t ops, auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+    };
+    auto row = [](const char* name, double ns, double bytes) {
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(12) << ns;
+        if (bytes > 0)
+            std::cout << std::setw(16) << bytes;
+        std::cout << '\n';
+    };
+    std::cout << std::left << std::setw(24) << (std::to_string(count) + " longs") << std::right
+              << std::setw(12) << "ns/op" << std::setw(16) << "bytes/version" << '\n';
+
+    MyPersistentVector<long> built;
+    row("transient push_back", nsPer(count, [&] {
+        auto builder = built.transient();
+        for (std::size_t i = 0; i < count; i++)
+            builder.push_back(long(i));
+        built = builder.persistent();
+    }), 0);
+    row("push_back", nsPer(count, [&] {
+        MyPersistentVector<long> v;
+        for (std::size_t i = 0; i < count; i++)
+            v = v.push_back(long(i));
+        doNotOptimize(&v);
+    }), 0);
+    MyVector<long> plain;
+    row("MyVector push_back", nsPer(count, [&] {
+        for (std::size_t i = 0; i < count; i++)
+            plain.push_back(long(i));
+    }), 0);
+
+    row("set", nsPer(UPDATES, [&] {
+        MyPersistentVector<long> v = built;
+        for (std::size_t i = 0; i < UPDATES; i++)
+            v = v.set(i * 7919 % count, long(i));
+        doNotOptimize(&v);
+    }), 0);
+    row("pop_back", nsPer(UPDATES, [&] {
+        MyPersistentVector<long> v = built;
+        for (std::size_t i = 0; i < UPDATES; i++)
+            v = v.pop_back();
+        doNotOptimize(&v);
+    }), 0);
+
+    // a history where each version changes one element of the one before
+    std::size_t before = heapInUse();
+    std::vector<MyPersistentVector<long>> history(1, built);
+    history.reserve(KEPT + 1);
+    double ns = nsPer(KEPT, [&] {
+        for (std::size_t i = 0; i < KEPT; i++)
+            history.push_back(history.back().set(i * 7919 % count, -long(i)));
+    });
+    row("kept set", ns, double(heapInUse() - before) / KEPT);
+
+    const std::size_t COPIES = 20;
+    std::vector<MyVector<long>> copies;
+    copies.reserve(COPIES);
+    ns = nsPer(COPIES, [&] {
+        for (std::size_t i = 0; i < COPIES; i++)
+        {
+            copies.push_back(copies.empty() ? plain : copies.back());
+            copies.back()[i * 7919 % count] = -long(i);
+        }
+    });
+    // large MyVector buffers are mapped directly, so count their capacity
+    row("kept MyVector copy", ns, double(plain.capacity() * sizeof(long)));
+
+    long total = 0;
+    row("iterate", nsPer(count, [&] {
+        for (long value : built)
+            total += value;
+    }), 0);
+    row("MyVector iterate", nsPer(count, [&] {
+        for (long value : plain)
+            total += value;
+    }), 0);
+    doNotOptimize(total);
+}
+
+// one-off comparisons from earlier changes, run with --experiments or --experiments=name
+void runExperiments(const std::string& only)
+{
+    const std::size_t COUNT = 1000000;
+    auto want = [&](const char* name) {
+        if (!only.empty() && only != name)
+            return false;
+        std::cout << "== " << name << '\n';
+        return true;
+    };
+
+    if (want("growth"))
+    {
+        std::cout << std::left << std::setw(24) << "policy"
+                  << std::right << std::setw(10) << "reallocs"
+                  << std::setw(16) << "bytes copied"
+                  << std::setw(12) << "capacity" << '\n';
+        benchGrowth<GeometricGrowth<>>("geometric 1.5x", COUNT);
+        benchGrowth<GeometricGrowth<2, 1>>("geometric 2x", COUNT);
+        benchGrowth<PowerOfTwoGrowth>("power of two", COUNT);
+        benchGrowth<PageRoundedGrowth<>>("page rounded", COUNT);
+        benchGrowth<FixedChunkGrowth<4096>>("fixed chunk 4096", COUNT);
+    }
+
+    if (want("relocation"))
+    {
+        std::cout << std::left << std::setw(24) << "push_back ns/op"
+                  << std::right << std::setw(12) << "elementwise"
+                  << std::setw(12) << "memcpy" << '\n';
+        benchRelocation<int>("int", COUNT * 10);
+        benchRelocation<Pod64>("64-byte POD", COUNT);
+    }
+
+    if (want("pmr"))
+    {
+        const std::size_t VECTORS = 100000;
+        std::pmr::monotonic_buffer_resource arena;
+        double heap = benchShortLived<MyVector<int>>(VECTORS);
+        double pmr = benchShortLived<MyPmrVector<int>>(VECTORS, 2, &arena);
+        std::cout << std::left << std::setw(24) << "16-int vector ns" << std::right
+                  << std::setw(12) << "heap" << std::setw(12) << "arena" << '\n'
+                  << std::setw(24) << "" << std::setw(12) << heap << std::setw(12) << pmr << '\n';
+    }
+
+    if (want("small"))
+    {
+        std::cout << std::left << std::setw(24) << "allocs per vector"
+                  << std::right << std::setw(12) << "MyVector"
+                  << std::setw(12) << "Small<16>" << '\n';
+        for (int elements : {4, 16, 64})
+        {
+            double heap = benchAllocations<MyVector<NotRelocatable<int>>>(10000, elements);
+            double small = benchAllocations<MySmallVector<NotRelocatable<int>, 16>>(10000, elements);
+            std::cout << std::left << std::setw(24) << (std::to_string(elements) + " elements") << std::right
+                      << std::setw(12) << heap << std::setw(12) << small << '\n';
+        }
+    }
+
+    if (want("lazy"))
+    {
+        std::cout << std::left << std::setw(24) << "1M empty vectors"
+                  << std::right << std::setw(12) << "ns/vector"
+                  << std::setw(12) << "allocs" << '\n';
+        benchEmpty<MyVector<NotRelocatable<int>>>("lazy default", COUNT);
+        benchEmpty<MyVector<NotRelocatable<int>>>("eager capacity 2", COUNT, 2);
+    }
+
+    if (want("bulk"))
+        benchBulkLoad(COUNT * 10);
+
+    if (want("removal"))
+        benchRemovals();
+
+    if (want("swap_remove"))
+        benchSwapRemove();
+
+    if (want("algorithms"))
+        benchAlgorithms(COUNT * 10);
+
+    if (want("concurrent"))
+        benchConcurrentScaling(COUNT * 10);
+
+    if (want("soa"))
+        benchSoA(COUNT * 50);
+
+    if (want("simd"))
+    {
+        std::cout << std::left << std::setw(24) << "GB/s"
+                  << std::right << std::setw(10) << "sum" << std::setw(10) << "minmax"
+                  << std::setw(10) << "count_eq" << std::setw(10) << "find" << std::setw(10) << "dot" << '\n';
+        benchSimd<int>("int", COUNT * 4);
+        benchSimd<float>("float", COUNT * 4);
+        benchSimd<double>("double", COUNT * 2);
+    }
+
+    if (want("parallel"))
+        benchParallelScaling(COUNT * 10);
+
+    if (want("mapped"))
+        benchColdLoad(COUNT * 10);
+
+    if (want("serialize"))
+        benchSerialize(COUNT * 20);
+
+    if (want("view"))
+    {
+        std::cout << std::left << std::setw(24) << "ns per slice" << std::right
+                  << std::setw(12) << "copy" << std::setw(12) << "view"
+                  << std::setw(14) << "copy allocs" << std::setw(14) << "view allocs" << '\n';
+        benchSlices(COUNT * 10, 16);
+        benchSlices(COUNT * 10, 1000);
+    }
+
+    if (want("exceptions"))
+    {
+        std::cout << std::left << std::setw(24) << "string wrapper" << std::right
+                  << std::setw(12) << "push ns" << std::setw(14) << "copies/push"
+                  << std::setw(12) << "insert ns" << std::setw(14) << "copies/insert" << '\n';
+        benchExceptionSafety<true>("noexcept move", COUNT);
+        benchExceptionSafety<false>("throwing move", COUNT);
+    }
+
+    if (want("resize"))
+        benchDecode(COUNT * 50);
+
+    if (want("cow"))
+    {
+        std::cout << std::left << std::setw(24) << "1M longs" << std::right
+                  << std::setw(12) << "ticks/s" << std::setw(14) << "snapshots/s" << '\n';
+        for (int readers : {1, 4})
+        {
+            benchSnapshots<MyVector<long>>("MyVector", COUNT, readers);
+            benchSnapshots<MyCowVector<long>>("MyCowVector", COUNT, readers);
+        }
+    }
+
+    if (want("persistent"))
+        benchPersistent(COUNT);
+
+    if (want("large_growth"))
+    {
+        std::cout << std::left << std::setw(24) << "grow to 1 GB"
+                  << std::right << std::setw(12) << "peak MB"
+                  << std::setw(14) << "worst ms"
+                  << std::setw(12) << "total ms" << '\n';
+        benchLargeGrowth<NotRelocatable<int>>("operator new + move", std::size_t(1) << 30);
+        benchLargeGrowth<int>("realloc/mremap", std::size_t(1) << 30);
+    }
+}
+
+// ---- benchmark suite ----
+
+// MyVector calls it ValueType, std::vector value_type
+template<typename Vector>
+using ElementOf = std::remove_cvref_t<decltype(std::declval<Vector&>()[0])>;
+
+// whether growing the capacity relocates the existing elements
+template<typename Vector>
+inline constexpr bool RelocatesOnGrowth = true;
+
+template<typename T, std::size_t FirstChunk>
+inline constexpr bool RelocatesOnGrowth<MySegmentedVector<T, FirstChunk>> = false;
+
+inline int makeValue(int*, std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+inline std::string makeValue(std::string*, std::size_t i)
+{
+    return std::to_string(i);
+}
+
+inline Pod64 makeValue(Pod64*, std::size_t i)
+{
+    return Pod64{{static_cast<long long>(i)}};
+}
+
+template<typename T>
+T makeValue(std::size_t i)
+{
+    return makeValue(static_cast<T*>(nullptr), i);
+}
+
+// the few operations MyVector and std::vector spell differently
+template<typename T, typename... Rest>
+void insertAt(MyVector<T, Rest...>& v, std::size_t index, T&& item)
+{
+    v.insert(index, std::move(item));
+}
+
+template<typename T>
+void insertAt(std::vector<T>& v, std::size_t index, T&& item)
+{
+    v.insert(v.begin() + index, std::move(item));
+}
+
+template<typename T, typename... Rest>
+void removeAt(MyVector<T, Rest...>& v, std::size_t index)
+{
+    v.remove(index);
+}
+
+template<typename T>
+void removeAt(std::vector<T>& v, std::size_t index)
+{
+    v.erase(v.begin() + index);
+}
+
+template<typename Vector>
+void reallocate(Vector& v, std::size_t capacity)
+{
+    v.reserve(capacity);
+}
+
+template<typename Vector>
+Vector makeVector(std::size_t size)
+{
+    using T = ElementOf<Vector>;
+    Vector v;
+    for (std::size_t i = 0; i < size; i++)
+        v.push_back(makeValue<T>(i));
+    return v;
+}
+
+// number of middle insertions/removals timed per iteration, fewer for huge vectors
+inline std::size_t shiftOps(std::size_t size)
+{
+    return std::min(size, std::clamp<std::size_t>(100000000 / size, 1, 1000));
+}
+
+template<typename Vector>
+void BM_push_back(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    while (state.keepRunning())
+    {
+        Vector v;
+        for (std::size_t i = 0; i < state.range(); i++)
+        {
+            std::size_t cap = v.capacity();
+            v.push_back(makeValue<T>(i));
+            if (RelocatesOnGrowth<Vector> && v.capacity() != cap)
+                state.addBytesMoved((v.size() - 1) * sizeof(T));
+        }
+        doNotOptimize(v.back());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+template<typename Vector>
+void BM_emplace_back(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    while (state.keepRunning())
+    {
+        Vector v;
+        for (std::size_t i = 0; i < state.range(); i++)
+        {
+            std::size_t cap = v.capacity();
+            v.emplace_back(makeValue<T>(i));
+            if (RelocatesOnGrowth<Vector> && v.capacity() != cap)
+                state.addBytesMoved((v.size() - 1) * sizeof(T));
+        }
+        doNotOptimize(v.back());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+template<typename Vector>
+void BM_insert(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    const std::size_t ops = shiftOps(state.range());
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        Vector v = makeVector<Vector>(state.range());
+        state.resumeTiming();
+        for (std::size_t i = 0; i < ops; i++)
+        {
+            state.addBytesMoved((v.size() - v.size() / 2) * sizeof(T));
+            insertAt(v, v.size() / 2, makeValue<T>(i));
+        }
+        doNotOptimize(v.data());
+    }
+    state.setItemsProcessed(state.iterations() * ops);
+}
+
+template<typename Vector>
+void BM_remove(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    const std::size_t ops = shiftOps(state.range());
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        Vector v = makeVector<Vector>(state.range());
+        state.resumeTiming();
+        for (std::size_t i = 0; i < ops; i++)
+        {
+            state.addBytesMoved((v.size() - v.size() / 2 - 1) * sizeof(T));
+            removeAt(v, v.size() / 2);
+        }
+        doNotOptimize(v.data());
+    }
+    state.setItemsProcessed(state.iterations() * ops);
+}
+
+// reallocate a full buffer to twice its capacity
+template<typename Vector>
+void BM_resize(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        Vector v = makeVector<Vector>(state.range());
+        state.resumeTiming();
+        reallocate(v, state.range() * 2);
+        state.addBytesMoved(state.range() * sizeof(T));
+        doNotOptimize(v.data());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+template<typename Vector>
+void BM_copy(BenchState& state)
+{
+    using T = ElementOf<Vector>;
+    Vector source = makeVector<Vector>(state.range());
+    while (state.keepRunning())
+    {
+        Vector copy(source);
+        state.addBytesMoved(state.range() * sizeof(T));
+        doNotOptimize(copy.back());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+template<typename Vector>
+void BM_move(BenchState& state)
+{
+    Vector source = makeVector<Vector>(state.range());
+    while (state.keepRunning())
+    {
+        Vector moved(std::move(source));
+        doNotOptimize(moved.data());
+        source = std::move(moved);
+    }
+}
+
+template<typename Vector>
+void BM_iterate(BenchState& state)
+{
+    Vector v = makeVector<Vector>(state.range());
+    while (state.keepRunning())
+    {
+        std::size_t touched = 0;
+        for (const auto& item : v)
+        {
+            doNotOptimize(item);
+            ++touched;
+        }
+        doNotOptimize(touched);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+// the subset that makes sense for a container without contiguous storage
+template<typename Vector>
+void registerAppendSuite(const std::string& container, const std::string& type)
+{
+    using T = ElementOf<Vector>;
+    registerBenchmark("push_back", container, type, sizeof(T), BM_push_back<Vector>);
+    registerBenchmark("emplace_back", container, type, sizeof(T), BM_emplace_back<Vector>);
+    registerBenchmark("copy", container, type, sizeof(T), BM_copy<Vector>);
+    registerBenchmark("iterate", container, type, sizeof(T), BM_iterate<Vector>);
+}
+
+template<typename Vector>
+void registerSuite(const std::string& container, const std::string& type)
+{
+    using T = ElementOf<Vector>;
+    registerBenchmark("push_back", container, type, sizeof(T), BM_push_back<Vector>);
+    registerBenchmark("emplace_back", container, type, sizeof(T), BM_emplace_back<Vector>);
+    registerBenchmark("insert", container, type, sizeof(T), BM_insert<Vector>);
+    registerBenchmark("remove", container, type, sizeof(T), BM_remove<Vector>);
+    registerBenchmark("resize", container, type, sizeof(T), BM_resize<Vector>);
+    registerBenchmark("copy", container, type, sizeof(T), BM_copy<Vector>);
+    registerBenchmark("move", container, type, sizeof(T), BM_move<Vector>);
+    registerBenchmark("iterate", container, type, sizeof(T), BM_iterate<Vector>);
+}
+
+void writeJson(const std::string& path, const std::vector<BenchResult>& results)
+{
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"op\": \"" << r.benchmark->op
+            << "\", \"container\": \"" << r.benchmark->container << "\", \"type\": \"" << r.benchmark->type
+            << "\", \"size\": " << r.size << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp << ", \"allocations\": " << r.allocations
+            << ", \"bytes_moved\": " << r.bytesMoved << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// usage: bench [--filter=substring] [--max-size=N] [--max-bytes=N] [--min-time=seconds]
+//              [--json=path] [--experiments[=name]]
+int main(int argc, char** argv)
+{
+    std::string filter, jsonPath;
+    std::size_t maxSize = 100000000;
+    std::size_t maxBytes = std::size_t(2) << 30;
+    double minTime = 0.05;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        std::string value = arg.substr(arg.find('=') + 1);
+        if (arg == "--experiments" || arg.rfind("--experiments=", 0) == 0)
+        {
+            runExperiments(arg == "--experiments" ? "" : value);
+            return 0;
+        }
+        else if (arg.rfind("--filter=", 0) == 0)
+            filter = value;
+        else if (arg.rfind("--max-size=", 0) == 0)
+            maxSize = std::stoull(value);
+        else if (arg.rfind("--max-bytes=", 0) == 0)
+            maxBytes = std::stoull(value);
+        else if (arg.rfind("--min-time=", 0) == 0)
+            minTime = std::stod(value);
+        else if (arg.rfind("--json=", 0) == 0)
+            jsonPath = value;
+        else
+        {
+            std::cerr << "unknown option " << arg << '\n';
+            return 1;
+        }
+    }
+
+    registerSuite<MyVector<int>>("MyVector", "int");
+    registerSuite<std::vector<int>>("std::vector", "int");
+    registerSuite<MyVector<Pod64>>("MyVector", "pod64");
+    registerSuite<std::vector<Pod64>>("std::vector", "pod64");
+    registerSuite<MyVector<std::string>>("MyVector", "string");
+    registerSuite<std::vector<std::string>>("std::vector", "string");
+    registerAppendSuite<MySegmentedVector<int>>("MySegmentedVector", "int");
+    registerAppendSuite<MySegmentedVector<Pod64>>("MySegmentedVector", "pod64");
+
+    std::vector<BenchResult> results;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right
+              << std::setw(14) << "ns/op" << std::setw(12) << "allocs"
+              << std::setw(16) << "bytes moved" << std::setw(12) << "iterations" << '\n';
+    for (const Benchmark& bm : benchmarks())
+    {
+        for (std::size_t size = 10; size <= maxSize; size *= 10)
+        {
+            // the source, the result and a reallocation can all be live at once
+            if (size * bm.elementSize * 3 > maxBytes)
+                break;
+            if (!filter.empty() && benchName(bm, size).find(filter) == std::string::npos)
+                continue;
+            BenchResult result = runBenchmark(bm, size, minTime * 1e9);
+            std::cout << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(14) << result.nsPerOp << std::setw(12) << result.allocations
+                      << std::setw(16) << std::setprecision(0) << result.bytesMoved
+                      << std::setw(12) << result.iterations << std::endl;
+            results.push_back(result);
+        }
+    }
+
+    if (!jsonPath.empty())
+        writeJson(jsonPath, results);
+}
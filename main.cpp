@@ -1,25 +1,33 @@
 #include <iostream> 
 
 #include "MyVector.hpp"
+#include "MyVectorView.hpp"
 
 #define PRINT(x) std::cout << x
 #define NEWLINE std::cout << '\n'
 #define PRINTLN(x) std::cout << x << '\n'
 
 template<typename T>
-void printArray(const MyVector<T>& arr)
+void printArray(MyVectorView<T> arr)
 {
     for (const auto& i : arr)
         std::cout << i << ' ';  
     std::cout << '\n';
 }
 
+template<typename T>
+void printArray(const MyVector<T>& arr)
+{
+    printArray(MyVectorView(arr));
+}
+
 int main(void)
 {
     MyVector<int> arr;
     for (int i = 0; i < 20; i++)
         arr.push_back(i);
     printArray(arr);
+    printArray(MyVectorView(arr).subview(5, 10));
     PRINT(arr.size());
     NEWLINE;
     //arr.remove(19);
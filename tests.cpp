@@ -1,9 +1,36 @@
 #include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#define MYVECTOR_STATS
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
 #include "MyVector.hpp"
+#include "MySmallVector.hpp"
+#include "MyConcurrentVector.hpp"
+#include "MySegmentedVector.hpp"
+#include "MySoAVector.hpp"
+#include "MyVectorSimd.hpp"
+#include "MyVectorParallel.hpp"
+#include "MyMappedVector.hpp"
+#include "MyVectorSerialize.hpp"
+#include "MyVectorView.hpp"
+#include "MyCowVector.hpp"
+#include "MyPersistentVector.hpp"
 
 TEST_CASE("MyVector")
 {
@@ -24,3 +51,1501 @@ TEST_CASE("MyVector")
     arr.clear();
     CHECK(arr.empty());
 }
+
+TEST_CASE("GrowthPolicy")
+{
+    CHECK(GeometricGrowth<>::grow(2, 3, sizeof(int)) == 3);
+    CHECK(GeometricGrowth<2, 1>::grow(4, 5, sizeof(int)) == 8);
+    CHECK(PowerOfTwoGrowth::grow(5, 6, sizeof(int)) == 8);
+    CHECK(PowerOfTwoGrowth::grow(8, 9, sizeof(int)) == 16);
+    CHECK(PageRoundedGrowth<4096>::grow(2, 3, sizeof(int)) == 1024);
+    CHECK(FixedChunkGrowth<10>::grow(10, 11, sizeof(int)) == 20);
+
+    // huge requests saturate instead of wrapping round to a tiny capacity
+    const std::size_t huge = SIZE_MAX / 2 + 2;
+    CHECK(GeometricGrowth<>::grow(SIZE_MAX / 2, SIZE_MAX / 2 + 1, 1) == SIZE_MAX);
+    CHECK(PowerOfTwoGrowth::grow(4, huge, 1) == SIZE_MAX);
+    CHECK(PowerOfTwoGrowth::grow(SIZE_MAX / 2 + 1, 0, 1) == SIZE_MAX);
+    CHECK(PowerOfTwoGrowth::grow(0, 0, 1) == 1);
+    CHECK(PageRoundedGrowth<4096>::grow(SIZE_MAX / 2, huge, 1) >= huge);
+    CHECK(FixedChunkGrowth<10>::grow(SIZE_MAX - 5, SIZE_MAX - 4, 1) == SIZE_MAX);
+    MyVector<int, PowerOfTwoGrowth> refused;
+    CHECK_THROWS_AS(refused.resize(huge), std::length_error);
+
+    MyVector<int, PowerOfTwoGrowth> arr;
+    for (int i = 0; i < 5; i++)
+        arr.push_back(i);
+    CHECK(arr.capacity() == 8);
+    arr.insert(0, 42);
+    arr.emplace_back(7);
+    CHECK(arr.front() == 42);
+    CHECK(arr.back() == 7);
+    CHECK(arr.size() == 7);
+
+    MyVector<int, FixedChunkGrowth<16>> chunked;
+    for (int i = 0; i < 20; i++)
+        chunked.push_back(i);
+    CHECK(chunked.capacity() == 32);
+    CHECK(chunked[19] == 19);
+}
+
+TEST_CASE("trivially relocatable shifting")
+{
+    CHECK(is_trivially_relocatable_v<int>);
+    CHECK_FALSE(is_trivially_relocatable_v<std::string>);
+
+    MyVector<int> arr{1, 2, 4, 5};
+    arr.insert(2, 3);
+    arr.insert(arr.size(), 6);
+    arr.insert(0, 0);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{0, 1, 2, 3, 4, 5, 6}.begin()));
+    arr.remove(3);
+    arr.remove(0);
+    arr.remove(arr.size() - 1);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 2, 4, 5}.begin()));
+    CHECK(arr.size() == 4);
+}
+
+TEST_CASE("ReallocStorage")
+{
+    const std::size_t SMALL = 1024;
+    const std::size_t LARGE = MYVECTOR_MREMAP_THRESHOLD;
+    char* p = static_cast<char*>(ReallocStorage::allocate(SMALL));
+    for (std::size_t i = 0; i < SMALL; i++)
+        p[i] = static_cast<char>(i);
+
+    p = static_cast<char*>(ReallocStorage::reallocate(p, SMALL, LARGE, SMALL));
+    CHECK(ReallocStorage::isMapped(LARGE));
+    CHECK(p[SMALL - 1] == static_cast<char>(SMALL - 1));
+    p[LARGE - 1] = 'x';
+
+    p = static_cast<char*>(ReallocStorage::reallocate(p, LARGE, LARGE * 2, LARGE));
+    CHECK(p[LARGE - 1] == 'x');
+    CHECK(p[10] == 10);
+
+    p = static_cast<char*>(ReallocStorage::reallocate(p, LARGE * 2, SMALL, SMALL));
+    CHECK(p[10] == 10);
+    ReallocStorage::deallocate(p, SMALL);
+    CHECK_THROWS_AS(ReallocStorage::allocate(SIZE_MAX), std::bad_alloc);
+
+    MyVector<int> arr;
+    const int COUNT = LARGE / sizeof(int) + 1000;
+    for (int i = 0; i < COUNT; i++)
+        arr.push_back(i);
+    CHECK(arr[0] == 0);
+    CHECK(arr[COUNT / 2] == COUNT / 2);
+    CHECK(arr.back() == COUNT - 1);
+    arr.shrinkToFit();
+    CHECK(arr.capacity() == arr.size());
+    CHECK(arr.back() == COUNT - 1);
+}
+
+TEST_CASE("MyPmrVector")
+{
+    alignas(std::max_align_t) char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    {
+        MyPmrVector<int> arr(&arena);
+        for (int i = 0; i < 100; i++)
+            arr.push_back(i);
+        CHECK(arr.size() == 100);
+        CHECK(arr.back() == 99);
+        CHECK(arr.get_allocator().resource() == &arena);
+        const char* p = reinterpret_cast<const char*>(arr.data());
+        CHECK(p >= buffer);
+        CHECK(p < buffer + sizeof(buffer));
+
+        MyPmrVector<int> moved(std::move(arr));
+        CHECK(moved.get_allocator().resource() == &arena);
+        CHECK(moved[50] == 50);
+
+        // copies don't propagate polymorphic allocators
+        MyPmrVector<int> copied(moved);
+        CHECK(copied.get_allocator().resource() == std::pmr::get_default_resource());
+        CHECK(copied[50] == 50);
+    }
+    MyPmrVector<int> list({1, 2, 3}, &arena);
+    CHECK(list.size() == 3);
+}
+
+TEST_CASE("MySmallVector")
+{
+    // a const vector only hands out const elements
+    static_assert(std::is_same_v<decltype(std::declval<const MySmallVector<int, 4>&>().data()), const int*>);
+
+    MySmallVector<int, 4> arr;
+    CHECK(arr.capacity() == 4);
+    for (int i = 0; i < 4; i++)
+        arr.push_back(i);
+    CHECK(arr.isInline());
+    arr.emplace_back(4);
+    CHECK_FALSE(arr.isInline());
+    CHECK(arr.capacity() == 6);
+    arr.insert(0, -1);
+    arr.remove(3);
+    CHECK(std::equal(arr.begin(), arr.end(), MySmallVector<int, 4>{-1, 0, 1, 3, 4}.begin()));
+    arr.pop_back();
+    arr.shrinkToFit();
+    CHECK(arr.isInline());
+    CHECK(arr.back() == 3);
+
+    MySmallVector<std::string, 2> strings{"a", "b"};
+    strings.push_back(strings[0]);
+    strings.insert(1, "c");
+    strings.remove(0);
+    CHECK(strings.size() == 3);
+    CHECK(strings[0] == "c");
+    CHECK(strings[2] == "a");
+
+    MySmallVector<std::string, 2> copied(strings);
+    MySmallVector<std::string, 2> moved(std::move(strings));
+    CHECK(strings.empty());
+    CHECK(strings.isInline());
+    CHECK(moved[1] == "b");
+    copied = moved;
+    moved.hardClear();
+    CHECK(copied[1] == "b");
+    CHECK(moved.capacity() == 2);
+}
+
+TEST_CASE("reserve and resize")
+{
+    MyVector<int> arr{1, 2, 3};
+    arr.reserve(100);
+    CHECK(arr.size() == 3);
+    CHECK(arr.capacity() == 100);
+    const int* buffer = arr.data();
+    arr.reserve(10); // never shrinks, so the buffer stays put
+    CHECK(arr.capacity() == 100);
+    CHECK(arr.data() == buffer);
+
+    arr.resize(6);
+    CHECK(arr.size() == 6);
+    CHECK(arr[2] == 3);
+    CHECK(arr[5] == 0);
+    arr.resize(8, 7);
+    CHECK(arr[7] == 7);
+    arr.resize(2);
+    CHECK(arr.size() == 2);
+    CHECK(arr.capacity() == 100);
+    arr.shrinkToFit();
+    arr.resize(5, arr[0]); // grows the buffer the value lives in
+    CHECK(arr[4] == 1);
+
+    // decoders write straight into the buffer without zero-filling it first
+    MyVector<unsigned> decoded;
+    decoded.resize_uninitialized(256);
+    for (unsigned i = 0; i < 256; i++)
+        decoded.data()[i] = i * i;
+    CHECK(decoded.size() == 256);
+    CHECK(decoded[255] == 255 * 255);
+
+    // a byte size that would wrap is refused instead of allocating a few bytes
+    CHECK(arr.max_size() == std::size_t(PTRDIFF_MAX) / sizeof(int));
+    CHECK_THROWS_AS(arr.reserve(std::size_t(1) << 62), std::length_error);
+    CHECK_THROWS_AS(decoded.resize_uninitialized(SIZE_MAX), std::length_error);
+    CHECK_THROWS_AS(MyVector<std::string>{}.reserve(SIZE_MAX / 2), std::length_error);
+    CHECK_THROWS_AS(MyVector<int>(std::size_t(1) << 62), std::length_error);
+    CHECK(arr.capacity() == 5);
+    CHECK(decoded.size() == 256);
+
+    MyVector<std::string> strings;
+    strings.resize(3, "ab");
+    strings.resize(5);
+    CHECK(strings[2] == "ab");
+    CHECK(strings[4].empty());
+    strings.resize(1);
+    CHECK(strings.size() == 1);
+
+    MySmallVector<std::string, 2> small;
+    small.resize(4, "x");
+    CHECK(!small.isInline());
+    small.resize(1);
+    small.resize(3);
+    CHECK(small[0] == "x");
+    CHECK(small[2].empty());
+    small.reserve(50);
+    CHECK(small.capacity() == 50);
+
+    MySegmentedVector<int, 4> segmented;
+    segmented.resize(20, 3);
+    segmented.resize(25, segmented[0]);
+    CHECK(segmented.size() == 25);
+    CHECK(segmented[24] == 3);
+    segmented.resize(10);
+    CHECK(segmented.size() == 10);
+    segmented.reserve(100);
+    CHECK(segmented.capacity() >= 100);
+}
+
+TEST_CASE("lazy allocation")
+{
+    CHECK(GeometricGrowth<>::grow(0, 1, sizeof(int)) == 2);
+    CHECK(PowerOfTwoGrowth::grow(0, 1, sizeof(int)) == 1);
+    CHECK(FixedChunkGrowth<8>::grow(0, 1, sizeof(int)) == 8);
+
+    MyVector<int> arr;
+    CHECK(arr.capacity() == 0);
+    CHECK(arr.data() == nullptr);
+    arr.insert(0, 1);
+    CHECK(arr.capacity() == 2);
+    CHECK(arr.front() == 1);
+
+    MyVector<int, PowerOfTwoGrowth> pow2;
+    pow2.emplace_back(1);
+    CHECK(pow2.capacity() == 1);
+
+    MyVector<int> copied(MyVector<int>{});
+    CHECK(copied.data() == nullptr);
+    copied.push_back(3);
+    copied.hardClear();
+    CHECK(copied.capacity() == 0);
+    copied.push_back(4);
+    CHECK(copied.back() == 4);
+}
+
+// append(a, b) with two values of the same type only means a range of iterators
+template<typename Vector, typename Arg>
+concept CanAppendPair = requires(Vector& v, Arg a) { v.append(a, a); };
+
+TEST_CASE("bulk append and range insert")
+{
+    const int values[] = {1, 2, 3, 4, 5};
+    MyVector<int> arr;
+    arr.append(values, 5);
+    CHECK(arr.size() == 5);
+    CHECK(arr.capacity() == 5);
+    arr.append(arr.data(), arr.size());
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 2, 3, 4, 5, 1, 2, 3, 4, 5}.begin()));
+    arr.shrinkToFit();
+    arr.append(arr.begin() + 1, arr.begin() + 3); // iterators into the buffer that grows
+    CHECK(arr.size() == 12);
+    CHECK(arr[10] == 2);
+    CHECK(arr[11] == 3);
+    static_assert(!CanAppendPair<MyVector<std::size_t>, std::size_t>);
+    static_assert(CanAppendPair<MyVector<int>, std::list<int>::iterator>);
+
+    arr.assign(std::begin(values), std::begin(values) + 3);
+    CHECK(arr.size() == 3);
+    arr.insert(1, std::begin(values) + 3, std::end(values));
+    arr.insert(arr.size(), std::begin(values), std::begin(values) + 1);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 4, 5, 2, 3, 1}.begin()));
+
+    std::istringstream in("7 8 9");
+    arr.insert(0, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    CHECK(arr.size() == 9);
+    CHECK(arr[2] == 9);
+    CHECK(arr[3] == 1);
+
+    std::list<long> numbers{20, 30};
+    MyVector<long> longs(4);
+    longs.append(numbers.begin(), numbers.end());
+    longs.insert(0, numbers.begin(), std::next(numbers.begin()));
+    CHECK(longs.size() == 3);
+    CHECK(longs.capacity() == 4);
+    CHECK(longs[0] == 20);
+    CHECK(longs[2] == 30);
+}
+
+TEST_CASE("batched removal")
+{
+    MyVector<int> arr{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    arr.remove_range(2, 4);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{0, 1, 4, 5, 6, 7, 8, 9}.begin()));
+    arr.remove_range(arr.size(), arr.size());
+    CHECK(arr.size() == 8);
+    CHECK_THROWS_AS(arr.remove_range(3, 9), std::out_of_range);
+
+    const std::size_t indices[] = {0, 3, 4, 7};
+    arr.remove_indices(indices, 4);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 4, 7, 8}.begin()));
+    CHECK(arr.size() == 4);
+    const std::size_t unsorted[] = {2, 1};
+    CHECK_THROWS_AS(arr.remove_indices(unsorted, 2), std::invalid_argument);
+    CHECK(arr.size() == 4);
+
+    CHECK(arr.erase_if([](int x) { return x % 2 == 0; }) == 2);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 7}.begin()));
+    CHECK(arr.size() == 2);
+}
+
+TEST_CASE("swap_remove")
+{
+    MyVector<int> arr{0, 1, 2, 3, 4};
+    arr.swap_remove(1);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{0, 4, 2, 3}.begin()));
+    arr.swap_remove(arr.size() - 1);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{0, 4, 2}.begin()));
+    CHECK_THROWS_AS(arr.swap_remove(3), std::out_of_range);
+
+    MyVector<int> evens{1, 2, 3, 4, 5, 6, 8};
+    CHECK(evens.swap_remove_if([](int x) { return x % 2 == 0; }) == 4);
+    CHECK(evens.size() == 3);
+    std::sort(evens.data(), evens.data() + evens.size());
+    CHECK(std::equal(evens.begin(), evens.end(), MyVector<int>{1, 3, 5}.begin()));
+}
+
+TEST_CASE("random access iterator")
+{
+    static_assert(std::contiguous_iterator<MyVector<int>::Iterator>);
+    static_assert(std::contiguous_iterator<MyVector<int>::ConstIterator>);
+    static_assert(std::is_same_v<decltype(*std::declval<MyVector<int>::ConstIterator>()), const int&>);
+
+    MyVector<int> arr{5, 3, 9, 1, 7};
+    std::sort(arr.begin(), arr.end());
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{1, 3, 5, 7, 9}.begin()));
+    CHECK(std::distance(arr.begin(), arr.end()) == 5);
+    CHECK(*std::lower_bound(arr.cbegin(), arr.cend(), 6) == 7);
+    CHECK(std::to_address(arr.begin() + 2) == arr.data() + 2);
+
+    MyVector<int>::Iterator it = arr.begin();
+    it += 3;
+    CHECK(*it == 7);
+    CHECK(it[-1] == 5);
+    CHECK(*(1 + arr.begin()) == 3);
+    CHECK(arr.end() - it == 2);
+    CHECK(arr.begin() < it);
+    CHECK(it >= arr.begin() + 3);
+
+    MyVector<int>::ConstIterator cit = it;
+    CHECK(cit == arr.cbegin() + 3);
+    CHECK(*(cit - 3) == 1);
+
+    const MyVector<int>& view = arr;
+    MyVector<int> copied;
+    copied.append(view.begin(), view.end());
+    CHECK(std::equal(copied.begin(), copied.end(), arr.begin()));
+}
+
+TEST_CASE("MyVectorStats")
+{
+    static_assert(std::is_empty_v<MyVectorStatsCounter<false>>);
+
+    MyVectorStats::resetGlobal();
+    MyVector<int> arr;
+    for (int i = 0; i < 5; i++)
+        arr.push_back(i);
+    arr.insert(1, 10);
+    arr.remove(0);
+    MyVector<int> copied(arr);
+
+    MyVectorStats stats = arr.stats();
+    CHECK(stats.resizes == 4);
+    CHECK(stats.allocations == 4);
+    CHECK(stats.bytesAllocated == (2 + 3 + 4 + 6) * sizeof(int));
+    CHECK(stats.elementsShifted == 4 + 5);
+    CHECK(copied.stats().elementsCopied == 5);
+
+    MyVector<std::size_t, GeometricGrowth<>, std::pmr::polymorphic_allocator<std::size_t>> moving;
+    moving.push_back(1);
+    moving.push_back(2);
+    moving.push_back(3);
+    CHECK(moving.stats().elementsMoved == 2);
+
+    MyVectorStats global = MyVectorStats::global();
+    CHECK(global.resizes == 4 + 2);
+    CHECK(global.elementsCopied == 5);
+
+    std::ostringstream out;
+    global.dump(out);
+    CHECK(out.str().find("resizes=6") != std::string::npos);
+}
+
+TEST_CASE("MyConcurrentVector stress")
+{
+    const int WRITERS = 4;
+    const int PER_WRITER = 50000;
+    MyConcurrentVector<long, 8> arr;
+    std::atomic<bool> done{false};
+    std::atomic<bool> readerOk{true};
+
+    // every published element must be fully written while writers are still going
+    std::thread reader([&] {
+        while (!done)
+        {
+            std::size_t count = 0;
+            for (long value : arr)
+            {
+                if (value < 0 || value % PER_WRITER >= PER_WRITER || value / PER_WRITER >= WRITERS)
+                    readerOk = false;
+                ++count;
+            }
+            if (count > arr.size())
+                readerOk = false;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; w++)
+        writers.emplace_back([&arr, w] {
+            for (int i = 0; i < PER_WRITER; i++)
+                arr.push_back(long(w) * PER_WRITER + i);
+        });
+    for (auto& t : writers)
+        t.join();
+    done = true;
+    reader.join();
+
+    CHECK(readerOk);
+    REQUIRE(arr.size() == std::size_t(WRITERS) * PER_WRITER);
+    std::vector<long> values(arr.begin(), arr.end());
+    std::sort(values.begin(), values.end());
+    for (std::size_t i = 0; i < values.size(); i++)
+        REQUIRE(values[i] == long(i));
+
+    long* first = &arr[0];
+    arr.push_back(-1);
+    CHECK(first == &arr[0]);
+    CHECK(arr.at(arr.size() - 1) == -1);
+
+    MyConcurrentVector<std::string> strings;
+    std::string hello = "hello";
+    CHECK(strings.push_back(hello) == 0);
+    CHECK(strings.emplace_back(3, 'x') == 1);
+    CHECK(strings[1] == "xxx");
+}
+
+struct Counted
+{
+    static inline int destroyed = 0;
+    long value = 0;
+    Counted(long v) noexcept : value(v) {}
+    ~Counted() { ++destroyed; }
+};
+
+TEST_CASE("MyConcurrentVector segment allocation failure")
+{
+    // the first segment is too large to ever allocate, so every push throws
+    // before any index is claimed
+    {
+        MyConcurrentVector<Counted, std::size_t(1) << 63> arr;
+        CHECK_THROWS_AS(arr.push_back(Counted{1}), std::bad_alloc);
+        CHECK_THROWS_AS(arr.emplace_back(2), std::bad_alloc);
+        CHECK(arr.size() == 0);
+        Counted::destroyed = 0;
+    }
+    // the destructor doesn't touch slots that were never claimed
+    CHECK(Counted::destroyed == 0);
+}
+
+TEST_CASE("MySegmentedVector")
+{
+    MySegmentedVector<int, 4> arr;
+    arr.push_back(0);
+    int* first = &arr[0];
+    for (int i = 1; i < 100; i++)
+        arr.push_back(i);
+    CHECK(first == &arr[0]);
+    CHECK(arr.size() == 100);
+    CHECK(arr.capacity() == 124);
+    for (int i = 0; i < 100; i++)
+        REQUIRE(arr[i] == i);
+    CHECK(std::distance(arr.begin(), arr.end()) == 100);
+    CHECK(std::equal(arr.cbegin(), arr.cbegin() + 3, MyVector<int>{0, 1, 2}.begin()));
+    CHECK(*(arr.begin() + 60) == 60);
+    CHECK(arr.end() - arr.begin() == 100);
+    CHECK(std::accumulate(arr.begin(), arr.end(), 0) == 4950);
+
+    arr.insert(0, -1);
+    arr.remove(50);
+    CHECK(arr.front() == -1);
+    CHECK(arr[50] == 50);
+    CHECK(arr.back() == 99);
+    std::sort(arr.begin(), arr.end(), std::greater<int>());
+    CHECK(arr.front() == 99);
+
+    while (arr.size() > 10)
+        arr.pop_back();
+    arr.shrinkToFit();
+    CHECK(arr.capacity() == 12);
+
+    MySegmentedVector<std::string, 2> strings{"a", "b", "c"};
+    strings.push_back(strings[0]);
+    MySegmentedVector<std::string, 2> copied(strings);
+    MySegmentedVector<std::string, 2> moved(std::move(strings));
+    CHECK(strings.empty());
+    CHECK(moved[3] == "a");
+    CHECK(copied.size() == 4);
+    copied.hardClear();
+    CHECK(copied.capacity() == 0);
+
+    copied = moved;
+    CHECK(copied.size() == 4);
+    CHECK(copied[3] == "a");
+    CHECK(&copied[0] != &moved[0]);
+    copied = copied;
+    CHECK(copied[0] == "a");
+
+    std::string* kept = &moved[0];
+    strings = std::move(moved);
+    CHECK(moved.empty());
+    CHECK(moved.capacity() == 0);
+    CHECK(&strings[0] == kept);
+    strings = std::move(strings);
+    CHECK(strings.size() == 4);
+}
+
+TEST_CASE("MySoAVector")
+{
+    MySoAVector<int, double, char> rows;
+    rows.push_back({1, 1.5, 'a'});
+    rows.push_back(std::make_tuple(2, 2.5, 'b'));
+    rows.emplace_back(3, 3.5, 'c');
+    rows.insert(0, {0, 0.5, 'z'});
+    CHECK(rows.size() == 4);
+
+    std::span<double> prices = rows.column<1>();
+    CHECK(prices.size() == 4);
+    CHECK(std::accumulate(prices.begin(), prices.end(), 0.0) == 8.0);
+    CHECK(rows.column<0>()[0] == 0);
+
+    auto [id, price, tag] = rows[2];
+    CHECK(id == 2);
+    price = 20.0;
+    CHECK(rows.column<1>()[2] == 20.0);
+    CHECK(std::get<2>(rows.row(3)) == 'c');
+
+    int idSum = 0;
+    for (auto row : rows)
+    {
+        idSum += std::get<0>(row);
+        std::get<2>(row) = 'x';
+    }
+    CHECK(idSum == 6);
+    CHECK(rows.column<2>()[1] == 'x');
+    CHECK(rows.end() - rows.begin() == 4);
+    static_assert(std::random_access_iterator<MySoAVector<int, double, char>::Iterator>);
+    static_assert(std::ranges::random_access_range<MySoAVector<int, double, char>>);
+    CHECK(std::get<0>(*(rows.cbegin() + 3)) == 3);
+
+    rows.remove(0);
+    rows.pop_back();
+    CHECK(rows.size() == 2);
+    CHECK(std::get<0>(rows.at(0)) == 1);
+    CHECK_THROWS_AS(rows.at(2), std::out_of_range);
+    rows.shrinkToFit();
+    CHECK(rows.capacity() == 2);
+    rows.resize(5);
+    CHECK(rows.column<1>()[4] == 0.0);
+    rows.reserve(64);
+    CHECK(rows.capacity() == 64);
+}
+
+TEST_CASE("simd kernels")
+{
+    using namespace myvec::simd;
+
+    // odd sizes exercise the scalar tails; the int products overflow int, so dot must widen
+    MyVector<int> ints;
+    MyVector<float> floats;
+    MyVector<double> doubles;
+    for (int i = 0; i < 1037; i++)
+    {
+        int value = (i * 7919) % 2003 - 1000;
+        ints.push_back(value * 60000);
+        floats.push_back(value / 8.0f);
+        doubles.push_back(value / 3.0);
+    }
+
+    const Level best = level();
+    for (std::size_t n : {0, 1, 3, 7, 8, 9, 31, 1037})
+    {
+        setLevel(Level::Scalar);
+        long long intSum = sum(ints.data(), n), intDot = dot(ints.data(), ints.data(), n);
+        float floatSum = sum(floats.data(), n), floatDot = dot(floats.data(), floats.data(), n);
+        double doubleSum = sum(doubles.data(), n), doubleDot = dot(doubles.data(), doubles.data(), n);
+        int needle = n ? ints[n - 1] : 0;
+
+        for (Level l : {Level::SSE41, Level::AVX2})
+        {
+            setLevel(l);
+            if (level() != l)
+                continue;
+            CAPTURE(n);
+            CHECK(sum(ints.data(), n) == intSum);
+            CHECK(dot(ints.data(), ints.data(), n) == intDot);
+            CHECK(sum(floats.data(), n) == doctest::Approx(floatSum));
+            CHECK(dot(floats.data(), floats.data(), n) == doctest::Approx(floatDot));
+            CHECK(sum(doubles.data(), n) == doctest::Approx(doubleSum));
+            CHECK(dot(doubles.data(), doubles.data(), n) == doctest::Approx(doubleDot));
+
+            CHECK(count_eq(ints.data(), n, needle) == std::size_t(std::count(ints.data(), ints.data() + n, needle)));
+            CHECK(count_eq(floats.data(), n, 0.0f) == std::size_t(std::count(floats.data(), floats.data() + n, 0.0f)));
+            CHECK(find_first(ints.data(), n, needle) == std::size_t(std::find(ints.data(), ints.data() + n, needle) - ints.data()));
+            CHECK(find_first(doubles.data(), n, 1e9) == n);
+            if (n)
+            {
+                auto [lo, hi] = std::minmax_element(doubles.data(), doubles.data() + n);
+                CHECK(minmax(doubles.data(), n) == std::make_pair(*lo, *hi));
+                auto [ilo, ihi] = std::minmax_element(ints.data(), ints.data() + n);
+                CHECK(minmax(ints.data(), n) == std::make_pair(*ilo, *ihi));
+                auto [flo, fhi] = std::minmax_element(floats.data(), floats.data() + n);
+                CHECK(minmax(floats.data(), n) == std::make_pair(*flo, *fhi));
+            }
+        }
+    }
+    setLevel(best);
+    CHECK(level() == best);
+
+    CHECK(sum(ints) == std::accumulate(ints.begin(), ints.end(), 0LL));
+    CHECK(find_first(ints, ints[500]) <= 500);
+    CHECK(dot(doubles, doubles) > 0);
+    CHECK_THROWS_AS(minmax(MyVector<int>()), std::invalid_argument);
+}
+
+TEST_CASE("parallel algorithms")
+{
+    using namespace myvec::parallel;
+
+    MyVector<long> values;
+    for (long i = 0; i < 100000; i++)
+        values.push_back((i * 7919) % 100003);
+
+    ThreadPool pool(4);
+    CHECK(pool.size() == 4);
+
+    MyVector<long> doubled(values);
+    parallel_for(doubled, [](long& x) { x *= 2; }, pool, 1000);
+    MyVector<long> squared(values);
+    parallel_transform(values, squared, [](long x) { return x * x; }, pool, 1000);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        REQUIRE(doubled[i] == values[i] * 2);
+        REQUIRE(squared[i] == values[i] * values[i]);
+    }
+    MyVector<long> shorter;
+    CHECK_THROWS_AS(parallel_transform(values, shorter, [](long x) { return x; }, pool), std::invalid_argument);
+
+    CHECK(parallel_reduce(values, 0L, std::plus<>(), pool, 1000) == std::accumulate(values.begin(), values.end(), 0L));
+    CHECK(parallel_reduce(MyVector<long>(), 5L, std::plus<>(), pool) == 5);
+
+    MyVector<long> sorted(values);
+    parallel_sort(sorted, std::less<>(), pool, 1000);
+    std::vector<long> expected(values.begin(), values.end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(std::equal(sorted.begin(), sorted.end(), expected.begin(), expected.end()));
+    parallel_sort(sorted, std::greater<>(), pool, 1000);
+    CHECK(std::is_sorted(sorted.begin(), sorted.end(), std::greater<>()));
+
+    // the first exception from any range reaches the caller
+    CHECK_THROWS_AS(parallel_for(doubled, [](long& x) { if (x == 0) throw std::runtime_error("zero"); }, pool, 100),
+                    std::runtime_error);
+}
+
+TEST_CASE("parallel ranges start on cache lines")
+{
+    using namespace myvec::parallel;
+
+    CHECK(detail::lineElements<long>() == 8);
+    CHECK(detail::lineElements<char[24]>() == 8);
+    CHECK(detail::chunkSize<char[24]>(10) == 16);
+
+    MyVector<long> values(1000);
+    ThreadPool pool(4);
+    for (std::size_t shift = 0; shift < 8; shift++)
+    {
+        // a buffer that starts `shift` longs into a line
+        const long* data = values.data() + shift;
+        std::size_t chunk = detail::chunkSize<long>(100);
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        detail::forEachRange(900, chunk, detail::lineSkew(data, chunk), pool, [&](std::size_t begin, std::size_t end) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ranges.emplace_back(begin, end);
+        });
+        std::sort(ranges.begin(), ranges.end());
+
+        CAPTURE(shift);
+        REQUIRE(!ranges.empty());
+        CHECK(ranges.front().first == 0);
+        CHECK(ranges.back().second == 900);
+        for (std::size_t i = 1; i < ranges.size(); i++)
+        {
+            CHECK(ranges[i].first == ranges[i - 1].second);
+            CHECK(reinterpret_cast<std::uintptr_t>(data + ranges[i].first) % CacheLine == 0);
+            CHECK(ranges[i].second - ranges[i].first <= chunk);
+        }
+    }
+}
+
+TEST_CASE("parallel_reduce is deterministic")
+{
+    using namespace myvec::parallel;
+
+    // float addition is not associative, so any change of order shows up in the low bits
+    MyVector<float> values;
+    for (int i = 0; i < 200000; i++)
+        values.push_back(((i * 7919) % 1000 - 500) * (i % 3 == 0 ? 1e-3f : 1e3f));
+
+    ThreadPool serial(1);
+    const float expected = parallel_reduce(values, 0.0f, std::plus<>(), serial, 1024);
+    for (std::size_t threads : {2, 3, 4, 8})
+    {
+        ThreadPool pool(threads);
+        for (int run = 0; run < 5; run++)
+            CHECK(parallel_reduce(values, 0.0f, std::plus<>(), pool, 1024) == expected);
+    }
+}
+
+// a fresh path in the temp directory, removed again when the test ends
+struct TempFile
+{
+    std::string path;
+
+    explicit TempFile(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / (name + "." + std::to_string(getpid()))).string())
+    {
+        std::filesystem::remove(path);
+    }
+
+    ~TempFile()
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_CASE("MyMappedVector")
+{
+    struct Point
+    {
+        int x;
+        double y;
+    };
+    TempFile file("mymappedvector");
+
+    {
+        MyMappedVector<Point> points(file.path);
+        CHECK(points.empty());
+        CHECK(points.capacity() == 0);
+        for (int i = 0; i < 10000; i++)
+            points.push_back({i, i * 0.5});
+        points.insert(0, {-1, -0.5});
+        points.remove(1);
+        points.insert(0, points[5]);
+        points.remove(0);
+        CHECK(points.size() == 10000);
+        CHECK(points.capacity() >= points.size());
+        CHECK(std::filesystem::file_size(file.path) == points.capacity() * sizeof(Point));
+        points.flush();
+        points.flush(true);
+    }
+    // closing cuts the file back to the elements
+    CHECK(std::filesystem::file_size(file.path) == 10000 * sizeof(Point));
+
+    {
+        MyMappedVector<Point> points(file.path);
+        CHECK(points.size() == 10000);
+        CHECK(points[0].x == -1);
+        CHECK(points.back().y == 9999 * 0.5);
+        points.emplace_back(Point{10000, 5000.0});
+        points.reserve(20000);
+        CHECK(points.capacity() == 20000);
+        CHECK(points.size() == 10001);
+        points.resize(10003, points[1]);
+        CHECK(points.back().x == points[1].x);
+        points.resize(10001);
+        points.shrinkToFit();
+        CHECK(points.capacity() == 10001);
+        points.pop_back();
+        points.shrinkToFit();
+    }
+
+    {
+        const MyMappedVector<Point> points(file.path, MapMode::ReadOnly);
+        CHECK(points.size() == 10000);
+        long sum = 0;
+        for (const Point& p : points)
+            sum += p.x;
+        CHECK(sum == 10000L * 9999 / 2 - 1);
+        CHECK_THROWS_AS(points.at(10000), std::out_of_range);
+    }
+
+    MyMappedVector<Point> readOnly(file.path, MapMode::ReadOnly);
+    CHECK(readOnly.readOnly());
+    CHECK_THROWS_AS(readOnly.push_back({0, 0}), std::logic_error);
+    CHECK_THROWS_AS(readOnly.resize(1), std::logic_error);
+    MyMappedVector<Point> moved(std::move(readOnly));
+    CHECK(moved.size() == 10000);
+    CHECK(readOnly.size() == 0);
+
+    // assigning over a vector closes its file, cut back to its elements
+    TempFile other("mymappedvector_other");
+    MyMappedVector<Point> target(other.path);
+    target.push_back({1, 1.0});
+    target.reserve(100);
+    target = std::move(moved);
+    CHECK(std::filesystem::file_size(other.path) == sizeof(Point));
+    CHECK(target.size() == 10000);
+    CHECK(target.readOnly());
+    CHECK(moved.size() == 0);
+
+    CHECK_THROWS_AS(MyMappedVector<int>(file.path + ".missing", MapMode::ReadOnly), std::system_error);
+    {
+        std::ofstream(file.path, std::ios::binary | std::ios::app) << 'x';
+    }
+    CHECK_THROWS_AS(MyMappedVector<Point>(file.path), std::invalid_argument);
+}
+
+TEST_CASE("serialization round trip fuzz")
+{
+    struct Sample
+    {
+        int id;
+        short tag;
+        double value;
+    };
+    TempFile file("myvector_serial");
+    std::mt19937 random(135);
+
+    for (int round = 0; round < 50; round++)
+    {
+        MyVector<Sample> samples;
+        std::size_t count = round == 0 ? 0 : random() % 5000;
+        for (std::size_t i = 0; i < count; i++)
+            samples.push_back(Sample{int(random()), short(random()), double(random()) / 7});
+
+        int fd = open(file.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        myvec::serialize(samples, fd);
+        CHECK(lseek(fd, 0, SEEK_CUR) == off_t(sizeof(myvec::SerialHeader) + count * sizeof(Sample)));
+
+        lseek(fd, 0, SEEK_SET);
+        MyVector<Sample> loaded = myvec::deserialize<Sample>(fd);
+        REQUIRE(loaded.size() == count);
+        CHECK((count == 0 || std::memcmp(loaded.data(), samples.data(), count * sizeof(Sample)) == 0));
+
+        {
+            myvec::MappedView<Sample> view(fd);
+            REQUIRE(view.size() == count);
+            CHECK((count == 0 || std::memcmp(view.data(), samples.data(), count * sizeof(Sample)) == 0));
+        }
+
+        // flipping any header field or element byte is caught
+        std::size_t bytes = sizeof(myvec::SerialHeader) + count * sizeof(Sample);
+        std::size_t offset = random() % bytes;
+        if (offset >= offsetof(myvec::SerialHeader, reserved) && offset < sizeof(myvec::SerialHeader))
+            offset = random() % offsetof(myvec::SerialHeader, reserved);
+        unsigned char byte;
+        pread(fd, &byte, 1, offset);
+        byte ^= 1 << (random() % 8);
+        pwrite(fd, &byte, 1, offset);
+        lseek(fd, 0, SEEK_SET);
+        CAPTURE(offset);
+        CHECK_THROWS_AS(myvec::deserialize<Sample>(fd), myvec::SerializationError);
+        CHECK_THROWS_AS(myvec::MappedView<Sample>{fd}, myvec::SerializationError);
+        close(fd);
+    }
+
+    int fd = open(file.path.c_str(), O_RDWR | O_TRUNC);
+    myvec::serialize(MyVector<int>{1, 2, 3}, fd);
+    lseek(fd, 0, SEEK_SET);
+    CHECK_THROWS_AS(myvec::deserialize<long>(fd), myvec::SerializationError);
+    CHECK(myvec::MappedView<int>{fd}.span()[2] == 3);
+    ftruncate(fd, sizeof(myvec::SerialHeader) + 2 * sizeof(int));
+    lseek(fd, 0, SEEK_SET);
+    CHECK_THROWS_AS(myvec::deserialize<int>(fd), myvec::SerializationError);
+    CHECK_THROWS_AS(myvec::view<int>(&fd, sizeof(fd)), myvec::SerializationError);
+    close(fd);
+}
+
+TEST_CASE("deserialize from a pipe")
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    MyVector<int> values{1, 2, 3, 4, 5};
+    myvec::serialize(values, fds[1]);
+    MyVector<int> loaded = myvec::deserialize<int>(fds[0]);
+    CHECK(std::equal(loaded.begin(), loaded.end(), values.begin(), values.end()));
+
+    // the header of an empty vector, whose checksum matches no elements
+    myvec::serialize(MyVector<int>(), fds[1]);
+    myvec::SerialHeader header;
+    REQUIRE(read(fds[0], &header, sizeof(header)) == sizeof(header));
+    close(fds[0]);
+    close(fds[1]);
+
+    // a pipe can't be measured, so a forged count must not size the allocation
+    for (std::uint64_t count : {std::uint64_t(1) << 62, std::uint64_t(1) << 40})
+    {
+        header.count = count;
+        REQUIRE(pipe(fds) == 0);
+        REQUIRE(write(fds[1], &header, sizeof(header)) == sizeof(header));
+        close(fds[1]);
+        CAPTURE(count);
+        CHECK_THROWS_AS(myvec::deserialize<int>(fds[0]), myvec::SerializationError);
+        close(fds[0]);
+    }
+}
+
+// a read-only view parameter accepts vectors, spans and slices alike
+static long sumView(MyVectorView<const long> values)
+{
+    return std::accumulate(values.begin(), values.end(), 0L);
+}
+
+TEST_CASE("MyVectorView")
+{
+    MyVector<long> values;
+    for (long i = 0; i < 10; i++)
+        values.push_back(i);
+
+    MyVectorStats::resetGlobal();
+    MyVectorView view(values);
+    static_assert(std::is_same_v<decltype(view), MyVectorView<long>>);
+    CHECK(view.size() == 10);
+    CHECK(view.data() == values.data());
+    CHECK(sumView(values) == 45);
+    CHECK(sumView(view.subview(2, 3)) == 2 + 3 + 4);
+    CHECK(sumView(view.subview(8)) == 8 + 9);
+    CHECK(sumView(view.first(2)) == 1);
+    CHECK(sumView(view.last(2)) == 17);
+    CHECK(view.subview(10).empty());
+    CHECK_THROWS_AS(view.subview(11), std::out_of_range);
+    CHECK_THROWS_AS(view.first(11), std::out_of_range);
+    CHECK_THROWS_AS(view.last(11), std::out_of_range);
+    CHECK_THROWS_AS(view.at(10), std::out_of_range);
+    // slicing never touches the heap
+    CHECK(MyVectorStats::global().allocations == 0);
+
+    // writes through a mutable view land in the vector
+    for (long& v : view.subview(5, 2))
+        v = 0;
+    view.back() = 100;
+    CHECK(values[5] == 0);
+    CHECK(values[6] == 0);
+    CHECK(values[9] == 100);
+
+    const MyVector<long>& constValues = values;
+    MyVectorView readOnly(constValues);
+    static_assert(std::is_same_v<decltype(readOnly), MyVectorView<const long>>);
+    static_assert(!std::is_convertible_v<const MyVector<long>&, MyVectorView<long>>);
+    MyVectorView<const long> fromMutable = view;
+    CHECK(fromMutable.front() == 0);
+
+    std::span<long> span = view.subview(1, 3);
+    CHECK(span.size() == 3);
+    CHECK(span[0] == 1);
+    MyVectorView fromSpan(span);
+    CHECK(fromSpan.size() == 3);
+    CHECK(sumView(std::span<const long>(span)) == 1 + 2 + 3);
+    CHECK(std::ranges::equal(MyVectorView(values).first(3), std::vector<long>{0, 1, 2}));
+
+    std::vector<std::size_t> doomed = {0, 9};
+    values.remove_indices(doomed);
+    CHECK(values.size() == 8);
+    CHECK(values.front() == 1);
+}
+
+// counts live instances so a test can check every construction is matched by a destruction
+struct Tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    Tracked(int v = 0) : value(v) { ++alive; }
+    Tracked(const Tracked& other) : value(other.value) { ++alive; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked() { --alive; }
+};
+
+TEST_CASE("element lifetime")
+{
+    Tracked::alive = 0;
+    {
+        MyVector<Tracked> arr;
+        for (int i = 0; i < 100; i++)
+            arr.emplace_back(i);
+        arr.push_back(arr[0]);
+        arr.insert(0, arr[50]);
+        arr.insert(101, Tracked(7));
+        const Tracked range[] = {1, 2, 3};
+        arr.insert(5, std::begin(range), std::end(range));
+        arr.append(std::begin(range), std::end(range));
+        CHECK(Tracked::alive == int(arr.size()) + 3);
+
+        arr.remove(0);
+        arr.swap_remove(0);
+        arr.remove_range(10, 20);
+        std::size_t doomed[] = {1, 3, 5};
+        arr.remove_indices(doomed, 3);
+        arr.erase_if([](const Tracked& t) { return t.value % 7 == 0; });
+        arr.pop_back();
+        CHECK(Tracked::alive == int(arr.size()) + 3);
+
+        MyVector<Tracked> copied(arr);
+        MyVector<Tracked> assigned;
+        assigned = copied;
+        assigned = assigned;
+        MyVector<Tracked> moved;
+        moved = std::move(copied);
+        CHECK(copied.empty());
+        CHECK(Tracked::alive == int(arr.size() + assigned.size() + moved.size()) + 3);
+
+        arr.resize(10);
+        CHECK(Tracked::alive == int(10 + assigned.size() + moved.size()) + 3);
+        assigned.clear();
+        moved.hardClear();
+        CHECK(Tracked::alive == 10 + 3);
+    }
+    CHECK(Tracked::alive == 0);
+
+    // strings own heap memory, run under the tests-asan target to catch leaks
+    MyVector<std::string> strings;
+    for (int i = 0; i < 100; i++)
+        strings.push_back("a long string that does not fit in the small buffer " + std::to_string(i));
+    strings.push_back(strings[0]);
+    strings.insert(0, strings[99]);
+    strings.emplace_back(5, 'x');
+    strings.remove(3);
+    strings.remove_range(10, 20);
+    strings.erase_if([](const std::string& s) { return s.back() == '7'; });
+    CHECK(strings.front().ends_with(" 99"));
+    CHECK(strings.back() == "xxxxx");
+    MyVector<std::string> other = strings;
+    other = MyVector<std::string>{"x", "y"};
+    CHECK(other.size() == 2);
+    strings.assign(other.begin(), other.end());
+    CHECK(strings[1] == "y");
+    strings.shrinkToFit();
+}
+
+// Copies throw when the countdown reaches zero; so do moves unless they are noexcept.
+template<bool NothrowMove>
+struct Throwing
+{
+    static inline int countdown = -1; // copies left before one throws, -1 for never
+    static inline int alive = 0;
+    int value;
+
+    static void tick()
+    {
+        if (countdown == 0)
+            throw std::runtime_error("copy failed");
+        if (countdown > 0)
+            --countdown;
+    }
+
+    Throwing(int v = 0) : value(v) { ++alive; }
+    Throwing(const Throwing& other) : value(other.value) { tick(); ++alive; }
+    Throwing(Throwing&& other) noexcept(NothrowMove) : value(other.value) { if (!NothrowMove) tick(); ++alive; }
+    Throwing& operator=(const Throwing&) = default;
+    Throwing& operator=(Throwing&&) = default;
+    ~Throwing() { --alive; }
+};
+
+// run op with every possible failing copy and check a throw changes nothing
+template<typename T, typename Op>
+void checkStrongGuarantee(const char* name, Op op)
+{
+    CAPTURE(name);
+    for (int countdown = 0;; countdown++)
+    {
+        MyVector<T> v;
+        for (int i = 0; i < 10; i++)
+            v.emplace_back(i);
+        v.shrinkToFit(); // full, so every insertion has to grow
+        const std::vector<int> before = [&] {
+            std::vector<int> values;
+            for (const T& t : v)
+                values.push_back(t.value);
+            return values;
+        }();
+        const std::size_t capacity = v.capacity();
+        const int alive = T::alive;
+
+        T::countdown = countdown;
+        try
+        {
+            op(v);
+            T::countdown = -1;
+            return;
+        }
+        catch (const std::runtime_error&)
+        {
+            T::countdown = -1;
+        }
+        CAPTURE(countdown);
+        REQUIRE(v.size() == before.size());
+        CHECK(v.capacity() == capacity);
+        for (std::size_t i = 0; i < before.size(); i++)
+            CHECK(v[i].value == before[i]);
+        CHECK(T::alive == alive);
+    }
+}
+
+template<typename T>
+void checkStrongGuarantees()
+{
+    T::alive = 0;
+    {
+        const T item(100);
+        const T range[] = {1, 2, 3};
+        checkStrongGuarantee<T>("push_back", [&](MyVector<T>& v) { v.push_back(item); });
+        checkStrongGuarantee<T>("push_back own element", [&](MyVector<T>& v) { v.push_back(v[3]); });
+        checkStrongGuarantee<T>("emplace_back", [&](MyVector<T>& v) { v.emplace_back(42); });
+        checkStrongGuarantee<T>("insert front", [&](MyVector<T>& v) { v.insert(0, item); });
+        checkStrongGuarantee<T>("insert middle", [&](MyVector<T>& v) { v.insert(5, T(7)); });
+        checkStrongGuarantee<T>("insert range", [&](MyVector<T>& v) { v.insert(4, std::begin(range), std::end(range)); });
+        checkStrongGuarantee<T>("append range", [&](MyVector<T>& v) { v.append(std::begin(range), std::end(range)); });
+        checkStrongGuarantee<T>("append own elements", [&](MyVector<T>& v) { v.append(v.data() + 2, 3); });
+        checkStrongGuarantee<T>("append own range", [&](MyVector<T>& v) { v.append(v.begin() + 2, v.begin() + 5); });
+        checkStrongGuarantee<T>("reserve", [&](MyVector<T>& v) { v.reserve(v.capacity() * 2); });
+        checkStrongGuarantee<T>("resize", [&](MyVector<T>& v) { v.resize(15); });
+        checkStrongGuarantee<T>("resize with own element", [&](MyVector<T>& v) { v.resize(15, v[3]); });
+        checkStrongGuarantee<T>("copy assignment", [&](MyVector<T>& v) {
+            MyVector<T> source{7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+            v = source;
+        });
+        checkStrongGuarantee<T>("copy construction", [&](MyVector<T>& v) { MyVector<T> copied(v); });
+    }
+    CHECK(T::alive == 0);
+}
+
+TEST_CASE("strong exception safety")
+{
+    checkStrongGuarantees<Throwing<false>>();
+    checkStrongGuarantees<Throwing<true>>();
+
+    // growth only moves when moving can't throw, otherwise it copies
+    MyVector<Throwing<true>> nothrow;
+    MyVector<Throwing<false>> throwing;
+    for (int i = 0; i < 100; i++)
+    {
+        nothrow.emplace_back(i);
+        throwing.emplace_back(i);
+    }
+    CHECK(nothrow.stats().elementsMoved > 0);
+    CHECK(nothrow.stats().elementsCopied == 0);
+    CHECK(throwing.stats().elementsMoved == 0);
+    CHECK(throwing.stats().elementsCopied > 0);
+
+    // so moving a container must not throw either, or containers of them copy
+    static_assert(std::is_nothrow_move_constructible_v<MyVector<int>>);
+    static_assert(std::is_nothrow_move_assignable_v<MyVector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<MySmallVector<int, 4>>);
+    static_assert(!std::is_nothrow_move_constructible_v<MySmallVector<Throwing<false>, 4>>);
+    static_assert(std::is_nothrow_move_constructible_v<MySegmentedVector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<MyCowVector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<MyPersistentVector<int>>);
+    static_assert(std::is_nothrow_move_constructible_v<MyMappedVector<int>>);
+    static_assert(std::is_nothrow_move_assignable_v<MyMappedVector<int>>);
+
+    MyVector<MyVector<Throwing<false>>> nested;
+    Throwing<false>::countdown = 0; // any element copy throws
+    for (int i = 0; i < 64; i++)
+    {
+        nested.emplace_back();
+        nested.back().emplace_back(i);
+    }
+    Throwing<false>::countdown = -1;
+    CHECK(nested.stats().elementsCopied == 0);
+    CHECK(nested[63][0].value == 63);
+}
+
+TEST_CASE("MySmallVector copies and moves that throw")
+{
+    using T = Throwing<false>;
+    T::alive = 0;
+    {
+        MySmallVector<T, 2> heap;
+        for (int i = 0; i < 40; i++)
+            heap.emplace_back(i);
+        MySmallVector<T, 2> inlined;
+        inlined.emplace_back(1);
+        inlined.emplace_back(2);
+        REQUIRE(inlined.isInline());
+        REQUIRE(T::alive == 42);
+
+        // a copy that fails partway frees the heap buffer and what it built
+        T::countdown = 20;
+        CHECK_THROWS_AS((MySmallVector<T, 2>{heap}), std::runtime_error);
+        CHECK(T::alive == 42);
+        T::countdown = 1;
+        CHECK_THROWS_AS((MySmallVector<T, 2>{T(1), T(2), T(3)}), std::runtime_error);
+        CHECK(T::alive == 42);
+
+        // growing and moving inline elements leave the source whole when a move throws
+        T::countdown = 1;
+        CHECK_THROWS_AS(inlined.push_back(T(3)), std::runtime_error);
+        T::countdown = 0;
+        CHECK_THROWS_AS((MySmallVector<T, 2>{std::move(inlined)}), std::runtime_error);
+        MySmallVector<T, 2> target;
+        CHECK_THROWS_AS(target = std::move(inlined), std::runtime_error);
+        T::countdown = -1;
+        CHECK(T::alive == 42);
+        REQUIRE(inlined.size() == 2);
+        CHECK(inlined.isInline());
+        CHECK(inlined[1].value == 2);
+        CHECK(target.empty());
+
+        MySmallVector<T, 2> moved(std::move(heap));
+        CHECK(moved.size() == 40);
+        CHECK(T::alive == 42);
+    }
+    CHECK(T::alive == 0);
+}
+
+TEST_CASE("MySegmentedVector copies that throw")
+{
+    using T = Throwing<false>;
+    T::alive = 0;
+    {
+        MySegmentedVector<T, 4> source;
+        for (int i = 0; i < 40; i++)
+            source.emplace_back(i);
+        MySegmentedVector<T, 4> target;
+        for (int i = 0; i < 5; i++)
+            target.emplace_back(100 + i);
+        REQUIRE(T::alive == 45);
+
+        // the elements and chunks already built are freed again
+        T::countdown = 20;
+        CHECK_THROWS_AS((MySegmentedVector<T, 4>{source}), std::runtime_error);
+        CHECK(T::alive == 45);
+        T::countdown = 20;
+        CHECK_THROWS_AS(target = source, std::runtime_error);
+        CHECK(T::alive == 45);
+        T::countdown = 1;
+        CHECK_THROWS_AS((MySegmentedVector<T, 4>{T(1), T(2), T(3)}), std::runtime_error);
+        T::countdown = -1;
+        CHECK(T::alive == 45);
+        REQUIRE(target.size() == 5);
+        CHECK(target[4].value == 104);
+    }
+    CHECK(T::alive == 0);
+}
+
+TEST_CASE("MySoAVector keeps its columns in step")
+{
+    using T = Throwing<false>;
+    MySoAVector<int, T, int> rows;
+    rows.reserve(8);
+    rows.push_back({1, T(10), 100});
+    const MySoAVector<int, T, int>::ValueType row{2, T(20), 200};
+
+    // the first column is already written when the second one throws
+    T::countdown = 0;
+    CHECK_THROWS_AS(rows.push_back(row), std::runtime_error);
+    CHECK_THROWS_AS(rows.insert(0, row), std::runtime_error);
+
+    // so is a throw while a column grows
+    T::countdown = -1;
+    rows.shrinkToFit();
+    T::countdown = 0;
+    CHECK_THROWS_AS(rows.push_back(row), std::runtime_error);
+    T::countdown = -1;
+    CHECK(rows.column<0>().size() == 1);
+    CHECK(rows.column<1>().size() == 1);
+    CHECK(rows.column<2>().size() == 1);
+    CHECK(std::get<0>(rows[0]) == 1);
+    CHECK(std::get<2>(rows[0]) == 100);
+
+    rows.push_back(row);
+    const auto& constRows = rows;
+    CHECK(std::get<1>(constRows.at(1)).value == 20);
+    CHECK_THROWS_AS(constRows.at(2), std::out_of_range);
+}
+
+TEST_CASE("MyCowVector")
+{
+    MyCowVector<int> arr{1, 2, 3};
+    MyCowVector<int> snapshot = arr;
+    CHECK(arr.use_count() == 2);
+    CHECK(std::as_const(arr).data() == std::as_const(snapshot).data());
+
+    // reading doesn't copy, the first change does
+    const MyCowVector<int>& reader = arr;
+    CHECK(reader[1] == 2);
+    CHECK(reader.at(2) == 3);
+    CHECK(arr.use_count() == 2);
+    arr.push_back(4);
+    CHECK(arr.use_count() == 1);
+    CHECK(snapshot.use_count() == 1);
+    CHECK(arr.size() == 4);
+    CHECK(snapshot.size() == 3);
+
+    snapshot = arr;
+    arr[0] = 10;
+    CHECK(snapshot[0] == 1);
+    snapshot = arr;
+    arr.insert(0, 0);
+    arr.remove(1);
+    CHECK(std::equal(arr.begin(), arr.end(), MyVector<int>{0, 2, 3, 4}.begin()));
+    CHECK(std::equal(snapshot.cbegin(), snapshot.cend(), MyVector<int>{10, 2, 3, 4}.begin()));
+    CHECK_THROWS_AS(snapshot.remove(4), std::out_of_range);
+    CHECK(snapshot.use_count() == 1);
+
+    // an argument may point into the buffer that detaching lets go of
+    MyCowVector<std::string> strings{"a", "b"};
+    {
+        MyCowVector<std::string> shared = strings;
+        strings.push_back(std::as_const(strings)[0]);
+        shared.push_back(std::as_const(shared)[1]);
+        CHECK(shared[2] == "b");
+    }
+    CHECK(strings[2] == "a");
+    MyCowVector<std::string> kept = strings;
+    strings.clear(); // leaves the shared buffer alone
+    CHECK(strings.empty());
+    CHECK(kept.size() == 3);
+    CHECK(kept.use_count() == 1);
+    MyCowVector<int> adopted(MyVector<int>{5, 6});
+    adopted.reserve(10);
+    CHECK(adopted.capacity() == 10);
+    CHECK(adopted.back() == 6);
+
+    // readers sum snapshots published by a writer that keeps changing the vector
+    const int N = 1000;
+    MyCowVector<long> published;
+    published.resize(N, 1);
+    std::mutex mutex;
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++)
+    {
+        readers.emplace_back([&] {
+            while (!done)
+            {
+                MyCowVector<long> snapshot;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    snapshot = published;
+                }
+                // every tick moves one unit between two elements, so the sum is fixed
+                if (std::accumulate(snapshot.cbegin(), snapshot.cend(), 0L) != N)
+                    bad++;
+            }
+        });
+    }
+    MyCowVector<long> current = published;
+    for (int tick = 0; tick < 2000; tick++)
+    {
+        current[tick % N]--;
+        current[(tick * 7 + 1) % N]++;
+        std::lock_guard<std::mutex> lock(mutex);
+        published = current;
+    }
+    done = true;
+    for (std::thread& reader : readers)
+        reader.join();
+    CHECK(bad == 0);
+}
+
+TEST_CASE("MyPersistentVector")
+{
+    // every version keeps its contents while later ones are made from it
+    const int N = 32 * 32 * 32 + 100; // deep enough for a three level trie
+    std::vector<MyPersistentVector<int>> versions(1);
+    for (int i = 0; i < N; i++)
+        versions.push_back(versions.back().push_back(i));
+    for (int n : {0, 1, 31, 32, 33, 1024, 1056, 32768, N})
+    {
+        CAPTURE(n);
+        REQUIRE(versions[n].size() == std::size_t(n));
+        for (int i = 0; i < n; i += 7)
+            CHECK(versions[n][i] == i);
+    }
+    std::vector<int> expected(N);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(std::equal(versions[N].begin(), versions[N].end(), expected.begin(), expected.end()));
+
+    MyPersistentVector<int> changed = versions[N].set(5, -5).set(N - 1, -1);
+    CHECK(changed[5] == -5);
+    CHECK(changed.back() == -1);
+    CHECK(versions[N][5] == 5);
+    CHECK(versions[N].back() == N - 1);
+    CHECK_THROWS_AS((void)changed.set(N, 0), std::out_of_range);
+
+    // pop back down through every level
+    MyPersistentVector<int> popped = versions[N];
+    for (int n = N; n > 0; n--)
+    {
+        REQUIRE(popped.back() == n - 1);
+        popped = popped.pop_back();
+    }
+    CHECK(popped.empty());
+    CHECK_THROWS_AS((void)popped.pop_back(), std::out_of_range);
+    CHECK(versions[N].size() == std::size_t(N));
+
+    // random changes against std::vector, keeping every version and its model
+    std::mt19937 random(25);
+    Tracked::alive = 0;
+    {
+        std::vector<MyPersistentVector<Tracked>> history(1);
+        std::vector<std::vector<int>> models(1);
+        for (int step = 0; step < 3000; step++)
+        {
+            MyPersistentVector<Tracked> next = history.back();
+            std::vector<int> model = models.back();
+            int op = random() % 4;
+            if (op == 0 && !model.empty())
+            {
+                next = next.pop_back();
+                model.pop_back();
+            }
+            else if (op == 1 && !model.empty())
+            {
+                std::size_t index = random() % model.size();
+                next = next.set(index, Tracked(step));
+                model[index] = step;
+            }
+            else
+            {
+                next = next.push_back(Tracked(step));
+                model.push_back(step);
+            }
+            history.push_back(next);
+            models.push_back(model);
+        }
+        for (std::size_t v = 0; v < history.size(); v += 97)
+        {
+            CAPTURE(v);
+            REQUIRE(history[v].size() == models[v].size());
+            for (std::size_t i = 0; i < models[v].size(); i++)
+                CHECK(history[v][i].value == models[v][i]);
+        }
+    }
+    CHECK(Tracked::alive == 0);
+
+    // a transient changes its own nodes in place, persistent() freezes them
+    MyPersistentVector<std::string> base{"a", "b"};
+    auto builder = base.transient();
+    for (int i = 0; i < 2000; i++)
+        builder.push_back(std::to_string(i));
+    MyPersistentVector<std::string> built = builder.persistent();
+    builder.set(0, "changed").set(1500, "changed").pop_back();
+    MyPersistentVector<std::string> after = builder.persistent();
+    CHECK(base.size() == 2);
+    CHECK(built.size() == 2002);
+    CHECK(built[0] == "a");
+    CHECK(built[1500] == "1498");
+    CHECK(built.back() == "1999");
+    CHECK(after.size() == 2001);
+    CHECK(after[0] == "changed");
+    CHECK(after[1500] == "changed");
+    CHECK(std::equal(after.begin() + 1501, after.end(), built.begin() + 1501));
+
+    // two builders never share an edit id, so one can't change the other's nodes
+    static_assert(!std::is_copy_constructible_v<MyPersistentVector<int>::Transient>);
+    static_assert(!std::is_copy_assignable_v<MyPersistentVector<int>::Transient>);
+    MyPersistentVector<int> numbers;
+    auto first = numbers.transient();
+    for (int i = 0; i < 100; i++)
+        first.push_back(i);
+    auto second = std::move(first);
+    second.set(5, -1);
+    first = numbers.transient();
+    first.push_back(7);
+    CHECK(second[5] == -1);
+    CHECK(second.size() == 100);
+    first = std::move(second);
+    second = numbers.transient();
+    for (int i = 0; i < 100; i++)
+        second.push_back(i);
+    second.set(5, 5);
+    CHECK(first[5] == -1);
+    CHECK(first.persistent()[99] == 99);
+}